@@ -0,0 +1,33 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace FXBoard {
+namespace Bench {
+
+/**
+ * 명령행 옵션 헬퍼 ("--name value" 형식)
+ */
+juce::String getOption(const juce::StringArray& args, const juce::String& name, const juce::String& defaultValue);
+bool hasFlag(const juce::StringArray& args, const juce::String& name);
+
+/**
+ * 쉼표 목록 파싱 ("32,64,128")
+ */
+std::vector<int> parseIntList(const juce::String& text);
+
+/**
+ * 정렬된 값에서 백분위수
+ */
+double percentile(const std::vector<double>& sorted, double fraction);
+
+/**
+ * 벤치마크 진입점
+ */
+int runLatencyBench(const juce::StringArray& args);
+int runVoiceBench(const juce::StringArray& args);
+int runKernelBench(const juce::StringArray& args);
+int runFirstHitBench(const juce::StringArray& args);
+
+} // namespace Bench
+} // namespace FXBoard
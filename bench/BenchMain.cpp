@@ -0,0 +1,89 @@
+#include "Bench.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace FXBoard {
+namespace Bench {
+
+juce::String getOption(const juce::StringArray& args, const juce::String& name, const juce::String& defaultValue) {
+    for (int i = 0; i + 1 < args.size(); ++i) {
+        if (args[i] == name) {
+            return args[i + 1];
+        }
+    }
+    return defaultValue;
+}
+
+bool hasFlag(const juce::StringArray& args, const juce::String& name) {
+    return args.contains(name);
+}
+
+std::vector<int> parseIntList(const juce::String& text) {
+    juce::StringArray tokens;
+    tokens.addTokens(text, ",", "");
+    
+    std::vector<int> values;
+    for (const auto& token : tokens) {
+        if (token.trim().isNotEmpty()) {
+            values.push_back(token.trim().getIntValue());
+        }
+    }
+    return values;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    auto index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size()))) ;
+    index = std::min(std::max<size_t>(index, 1), sorted.size());
+    return sorted[index - 1];
+}
+
+} // namespace Bench
+} // namespace FXBoard
+
+static void printUsage(const char* program) {
+    std::cout << "FXBoardBench - FXBoard performance benchmarks" << std::endl;
+    std::cout << "\nUsage: " << program << " <benchmark> [options]" << std::endl;
+    std::cout << "\nBenchmarks:" << std::endl;
+    std::cout << "  latency     Key-to-onset latency via uinput keyboard and a capture device" << std::endl;
+    std::cout << "              --buffers 32,64,128,256  --presses 200  --interval-ms 40  --rt" << std::endl;
+    std::cout << "  voices      Serial vs parallel voice rendering time per block (crossover point)" << std::endl;
+    std::cout << "              --voices 8,16,...,256  --buffer 64  --blocks 3000  --threads N  --cpu 0  --no-reverb  --rt" << std::endl;
+    std::cout << "              --samples 1  --format float|int16" << std::endl;
+    std::cout << "  kernels     SIMD voice render kernels vs the legacy per-sample loop, cost per interpolation mode" << std::endl;
+    std::cout << "              --buffers 16,64,256,1024  --frames 4000000  --voice-buffer 128" << std::endl;
+    std::cout << "  firsthit    First hit after idle vs repeat hit, per-sample heap buffers vs the sample arena" << std::endl;
+    std::cout << "              --samples 32  --length-ms 500  --buffer 64  --rounds 20  --huge-pages  --no-flush" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0) {
+        printUsage(argv[0]);
+        return argc < 2 ? 1 : 0;
+    }
+    
+    juce::StringArray args;
+    for (int i = 2; i < argc; ++i) {
+        args.add(argv[i]);
+    }
+    
+    juce::String benchmark(argv[1]);
+    if (benchmark == "latency") {
+        return FXBoard::Bench::runLatencyBench(args);
+    }
+    if (benchmark == "voices") {
+        return FXBoard::Bench::runVoiceBench(args);
+    }
+    if (benchmark == "kernels") {
+        return FXBoard::Bench::runKernelBench(args);
+    }
+    if (benchmark == "firsthit") {
+        return FXBoard::Bench::runFirstHitBench(args);
+    }
+    
+    std::cerr << "Unknown benchmark: " << argv[1] << std::endl;
+    printUsage(argv[0]);
+    return 1;
+}
@@ -0,0 +1,93 @@
+#include "CaptureDevice.h"
+#include "core/Clock.h"
+#include "core/Realtime.h"
+#include <ctime>
+
+namespace FXBoard {
+namespace Bench {
+
+CaptureDevice::CaptureDevice(double sr, int bs, int channels)
+    : juce::AudioIODevice("Capture", "FXBoardBench"),
+      sampleRate(sr), bufferSize(bs), numChannels(channels) {
+    channelData.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(bufferSize)));
+    for (auto& channel : channelData) {
+        channelPointers.push_back(channel.data());
+    }
+}
+
+CaptureDevice::~CaptureDevice() {
+    stop();
+}
+
+juce::StringArray CaptureDevice::getOutputChannelNames() {
+    juce::StringArray names;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        names.add("Out " + juce::String(ch + 1));
+    }
+    return names;
+}
+
+juce::BigInteger CaptureDevice::getActiveOutputChannels() const {
+    juce::BigInteger channels;
+    channels.setRange(0, numChannels, true);
+    return channels;
+}
+
+void CaptureDevice::start(juce::AudioIODeviceCallback* newCallback) {
+    if (running.load() || newCallback == nullptr) return;
+    
+    callback = newCallback;
+    callback->audioDeviceAboutToStart(this);
+    lateCallbacks = 0;
+    running = true;
+    thread = std::thread(&CaptureDevice::run, this);
+}
+
+void CaptureDevice::stop() {
+    if (!running.exchange(false)) return;
+    
+    if (thread.joinable()) {
+        thread.join();
+    }
+    if (callback != nullptr) {
+        callback->audioDeviceStopped();
+        callback = nullptr;
+    }
+}
+
+void CaptureDevice::run() {
+    if (rtPriority > 0) {
+        Realtime::configureCurrentThread(rtPriority, -1, "Capture");
+    }
+    
+    const auto periodNs = static_cast<uint64_t>(1.0e9 * bufferSize / sampleRate);
+    uint64_t deadline = monotonicNowNs();
+    juce::AudioIODeviceCallbackContext context {};
+    
+    while (running.load()) {
+        // 하드웨어 인터럽트처럼 주기 경계에서 깨어남
+        struct timespec ts;
+        ts.tv_sec = static_cast<time_t>(deadline / 1000000000ULL);
+        ts.tv_nsec = static_cast<long>(deadline % 1000000000ULL);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr);
+        
+        callback->audioDeviceIOCallbackWithContext(nullptr, 0, channelPointers.data(),
+                                                   numChannels, bufferSize, context);
+        
+        if (blockObserver) {
+            blockObserver(channelPointers.data(), numChannels, bufferSize, deadline + periodNs);
+        }
+        
+        deadline += periodNs;
+        
+        // 한 주기 이상 밀렸으면 xrun으로 보고 현재 시각에 다시 맞춤
+        uint64_t now = monotonicNowNs();
+        if (now > deadline + periodNs) {
+            lateCallbacks.fetch_add(1);
+            deadline = now;
+        }
+    }
+}
+
+} // namespace Bench
+} // namespace FXBoard
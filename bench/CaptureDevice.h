@@ -0,0 +1,79 @@
+#pragma once
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace FXBoard {
+namespace Bench {
+
+/**
+ * 사운드 카드 없는 더미 출력 디바이스
+ * 실제 디바이스처럼 주기마다 콜백을 호출하고 출력 블록을 관찰자에게 넘김
+ * 렌더한 블록은 한 주기 뒤에 재생된다고 가정 (더블 버퍼링)
+ */
+class CaptureDevice : public juce::AudioIODevice {
+public:
+    /**
+     * @param output 블록 출력, 채널 수, 샘플 수, 블록 첫 샘플이 재생되는 시각 (CLOCK_MONOTONIC ns)
+     */
+    using BlockObserver = std::function<void(const float* const* output, int numChannels,
+                                             int numSamples, uint64_t playbackNs)>;
+    
+    CaptureDevice(double sampleRate, int bufferSize, int numChannels = 2);
+    ~CaptureDevice() override;
+    
+    void setBlockObserver(BlockObserver observer) { blockObserver = std::move(observer); }
+    
+    /**
+     * 콜백 스레드 실시간 스케줄링 (start() 전에 호출, 0 = 일반)
+     */
+    void setRealtimePriority(int priority) { rtPriority = priority; }
+    
+    /**
+     * 주기를 놓친 횟수 (콜백이 다음 주기까지 끝나지 않음)
+     */
+    int getLateCallbacks() const { return lateCallbacks.load(); }
+    
+    // juce::AudioIODevice
+    juce::StringArray getOutputChannelNames() override;
+    juce::StringArray getInputChannelNames() override { return {}; }
+    juce::Array<double> getAvailableSampleRates() override { return { sampleRate }; }
+    juce::Array<int> getAvailableBufferSizes() override { return { bufferSize }; }
+    int getDefaultBufferSize() override { return bufferSize; }
+    juce::String open(const juce::BigInteger&, const juce::BigInteger&, double, int) override { return {}; }
+    void close() override { stop(); }
+    bool isOpen() override { return true; }
+    void start(juce::AudioIODeviceCallback* callback) override;
+    void stop() override;
+    bool isPlaying() override { return running.load(); }
+    juce::String getLastError() override { return {}; }
+    int getCurrentBufferSizeSamples() override { return bufferSize; }
+    double getCurrentSampleRate() override { return sampleRate; }
+    int getCurrentBitDepth() override { return 32; }
+    juce::BigInteger getActiveOutputChannels() const override;
+    juce::BigInteger getActiveInputChannels() const override { return {}; }
+    int getOutputLatencyInSamples() override { return bufferSize; }
+    int getInputLatencyInSamples() override { return 0; }
+    
+private:
+    void run();
+    
+    double sampleRate;
+    int bufferSize;
+    int numChannels;
+    int rtPriority = 0;
+    
+    std::vector<std::vector<float>> channelData;
+    std::vector<float*> channelPointers;
+    
+    juce::AudioIODeviceCallback* callback = nullptr;
+    BlockObserver blockObserver;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<int> lateCallbacks{0};
+};
+
+} // namespace Bench
+} // namespace FXBoard
@@ -0,0 +1,188 @@
+#include "Bench.h"
+#include "audio/SampleManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+#if JUCE_LINUX
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace FXBoard {
+namespace Bench {
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr size_t CACHE_FLUSH_BYTES = 64 * 1024 * 1024;
+
+struct HitTimes {
+    std::vector<double> firstUs;
+    std::vector<double> repeatUs;
+    long minorFaults = 0;  // 첫 트리거 블록들에서 발생한 페이지 폴트
+    long majorFaults = 0;
+};
+
+void fillKit(SampleManager& manager, int numSamples, int lengthMs) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> noise(-0.5f, 0.5f);
+    for (int s = 0; s < numSamples; ++s) {
+        // 길이를 조금씩 다르게 (실제 키트처럼 크기가 제각각)
+        const int length = static_cast<int>(SAMPLE_RATE * lengthMs / 1000.0) * (4 + s % 5) / 6;
+        juce::AudioBuffer<float> buffer(2, std::max(64, length));
+        for (int ch = 0; ch < 2; ++ch) {
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                buffer.setSample(ch, i, noise(rng));
+            }
+        }
+        manager.addSample("hit" + juce::String(s), buffer, SAMPLE_RATE);
+    }
+}
+
+void getFaults(long& minor, long& major) {
+#if JUCE_LINUX
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    minor = usage.ru_minflt;
+    major = usage.ru_majflt;
+#else
+    minor = major = 0;
+#endif
+}
+
+/**
+ * 오래 쉰 상태 흉내: 샘플 페이지를 회수 요청 (MADV_PAGEOUT, 잠긴 페이지는 제외됨) + 캐시 비우기
+ */
+void simulateIdle(const SampleManager& manager, std::vector<char>& scratch, bool flushCaches) {
+#if JUCE_LINUX && defined(MADV_PAGEOUT)
+    const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    for (const auto& id : manager.getAllSampleIds()) {
+        const auto& buffer = manager.getSample(id)->buffer;
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+            const auto start = reinterpret_cast<uintptr_t>(buffer.getReadPointer(ch));
+            const uintptr_t begin = (start + pageSize - 1) / pageSize * pageSize;
+            const uintptr_t end = (start + static_cast<uintptr_t>(buffer.getNumSamples()) * sizeof(float)) / pageSize * pageSize;
+            if (end > begin) {
+                madvise(reinterpret_cast<void*>(begin), end - begin, MADV_PAGEOUT);
+            }
+        }
+    }
+#else
+    juce::ignoreUnused(manager);
+#endif
+    if (!flushCaches) return;
+    for (size_t i = 0; i < scratch.size(); i += 64) {
+        scratch[i] = static_cast<char>(scratch[i] + 1);
+    }
+}
+
+double renderHit(SamplePlayer& player, const Sample* sample, juce::AudioBuffer<float>& block) {
+    player.setNumVoices(4);  // 이전 보이스 정지 (측정 밖에서)
+    block.clear();
+    auto start = std::chrono::steady_clock::now();
+    player.trigger(sample, 1.0f, 0);
+    player.renderNextBlock(block, 0, block.getNumSamples());
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+HitTimes measure(const SampleManager& manager, int bufferSize, int rounds, bool flushCaches) {
+    HitTimes result;
+    SamplePlayer player(4);
+    juce::AudioBuffer<float> block(2, bufferSize);
+    std::vector<char> scratch(CACHE_FLUSH_BYTES, 0);
+    const auto ids = manager.getAllSampleIds();
+
+    for (int round = 0; round < rounds; ++round) {
+        simulateIdle(manager, scratch, flushCaches);
+
+        long minorBefore, majorBefore, minorAfter, majorAfter;
+        getFaults(minorBefore, majorBefore);
+        for (const auto& id : ids) {
+            result.firstUs.push_back(renderHit(player, manager.getSample(id), block));
+        }
+        getFaults(minorAfter, majorAfter);
+        result.minorFaults += minorAfter - minorBefore;
+        result.majorFaults += majorAfter - majorBefore;
+
+        for (const auto& id : ids) {
+            result.repeatUs.push_back(renderHit(player, manager.getSample(id), block));
+        }
+    }
+
+    std::sort(result.firstUs.begin(), result.firstUs.end());
+    std::sort(result.repeatUs.begin(), result.repeatUs.end());
+    return result;
+}
+
+juce::String times(const std::vector<double>& sorted) {
+    return juce::String(percentile(sorted, 0.5), 2).paddedLeft(' ', 7) +
+           juce::String(percentile(sorted, 0.99), 2).paddedLeft(' ', 8) +
+           juce::String(sorted.back(), 2).paddedLeft(' ', 8);
+}
+
+} // namespace
+
+int runFirstHitBench(const juce::StringArray& args) {
+    int numSamples = juce::jlimit(1, 1024, getOption(args, "--samples", "32").getIntValue());
+    int lengthMs = juce::jlimit(10, 60000, getOption(args, "--length-ms", "500").getIntValue());
+    int bufferSize = juce::jlimit(16, 4096, getOption(args, "--buffer", "64").getIntValue());
+    int rounds = std::max(1, getOption(args, "--rounds", "20").getIntValue());
+    bool flushCaches = !hasFlag(args, "--no-flush");
+
+    // 같은 키트를 샘플별 힙 버퍼 / 아레나 두 방식으로
+    SampleManager heapKit;
+    SampleManager arenaKit;
+    arenaKit.setHugePages(hasFlag(args, "--huge-pages"));
+    fillKit(heapKit, numSamples, lengthMs);
+    fillKit(arenaKit, numSamples, lengthMs);
+    if (!arenaKit.packSamples()) {
+        std::cerr << "Failed to allocate the sample arena" << std::endl;
+        return 1;
+    }
+    const auto* arena = arenaKit.getArena();
+
+    std::cout << "First hit after idle vs repeat hit, " << numSamples << " stereo samples up to " << lengthMs
+              << " ms, " << bufferSize << "-frame block, " << rounds << " rounds" << std::endl;
+#if JUCE_LINUX && defined(MADV_PAGEOUT)
+    std::cout << "idle = MADV_PAGEOUT on sample memory";
+#else
+    std::cout << "idle = (no MADV_PAGEOUT here)";
+#endif
+    if (flushCaches) {
+        std::cout << " + " << CACHE_FLUSH_BYTES / (1024 * 1024) << " MB cache flush";
+    }
+    std::cout << std::endl;
+    std::cout << "\nstorage                first p50/p99/max (us)   repeat p50/p99/max (us)   p99 ratio   faults/hit" << std::endl;
+
+    int exitCode = 0;
+    for (int mode = 0; mode < 2; ++mode) {
+        const bool useArena = mode == 1;
+        const HitTimes result = measure(useArena ? arenaKit : heapKit, bufferSize, rounds, flushCaches);
+        const double ratio = percentile(result.firstUs, 0.99) / std::max(1.0e-3, percentile(result.repeatUs, 0.99));
+        const double hits = static_cast<double>(result.firstUs.size());
+
+        juce::String name = useArena ? juce::String("arena") + (arena->isLocked() ? " locked" : "") +
+                                           (arena->usesHugePages() ? " huge" : "")
+                                     : juce::String("heap");
+        std::cout << name.paddedRight(' ', 20) << "   " << times(result.firstUs) << "   " << times(result.repeatUs)
+                  << "    " << juce::String(ratio, 2).paddedLeft(' ', 6) << "x"
+                  << (juce::String(result.minorFaults / hits, 2) + " / " + juce::String(result.majorFaults / hits, 2)).paddedLeft(' ', 14)
+                  << std::endl;
+
+        if (useArena && result.majorFaults > 0) exitCode = 1;
+    }
+
+    std::cout << "\nfaults/hit = minor / major page faults per first-hit block. The arena should show none." << std::endl;
+    std::cout << "With the cache flush the first hit also pays cache misses on player state; --no-flush isolates paging." << std::endl;
+    if (arena != nullptr && !arena->isLocked()) {
+        std::cout << "Arena is not locked (memlock limit), so the kernel may still page it out." << std::endl;
+    }
+    return exitCode;
+}
+
+} // namespace Bench
+} // namespace FXBoard
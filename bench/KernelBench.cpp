@@ -0,0 +1,231 @@
+#include "Bench.h"
+#include "audio/RenderKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <random>
+
+namespace FXBoard {
+namespace Bench {
+
+namespace {
+
+/**
+ * 비교 기준: SIMD 커널 이전의 보이스 렌더링 루프 (샘플마다 채널 포인터 조회, 경계 검사, 선형 보간)
+ */
+void legacyRender(const juce::AudioBuffer<float>& sourceBuffer, juce::AudioBuffer<float>& outputBuffer,
+                  double position, int numSamples, float gain) {
+    int sourceChannels = sourceBuffer.getNumChannels();
+    int outputChannels = outputBuffer.getNumChannels();
+    int sourceSamples = sourceBuffer.getNumSamples();
+
+    for (int i = 0; i < numSamples; ++i) {
+        int pos = static_cast<int>(position);
+        if (pos >= sourceSamples) {
+            break;
+        }
+
+        float frac = static_cast<float>(position - pos);
+        int nextPos = juce::jmin(pos + 1, sourceSamples - 1);
+
+        for (int ch = 0; ch < outputChannels; ++ch) {
+            int srcCh = juce::jmin(ch, sourceChannels - 1);
+            const float* srcData = sourceBuffer.getReadPointer(srcCh);
+            float* outData = outputBuffer.getWritePointer(ch);
+
+            float sample = srcData[pos] * (1.0f - frac) + srcData[nextPos] * frac;
+            outData[i] += sample * gain;
+        }
+
+        position += 1.0;
+    }
+}
+
+juce::AudioBuffer<float> makeSource(int numChannels, int length) {
+    juce::AudioBuffer<float> source(numChannels, length);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    for (int ch = 0; ch < numChannels; ++ch) {
+        for (int i = 0; i < length; ++i) {
+            source.setSample(ch, i, noise(rng));
+        }
+    }
+    return source;
+}
+
+/**
+ * 블록 하나를 iterations번 렌더링 (소스 위치를 옮겨 가며), 출력 프레임당 나노초
+ */
+template <typename RenderFn>
+double timePerFrameNs(int blockSize, int iterations, int sourceLength, RenderFn&& render) {
+    int offset = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        render(offset);
+        offset += blockSize;
+        if (offset + blockSize >= sourceLength) offset = 0;
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    return ns / (static_cast<double>(iterations) * blockSize);
+}
+
+/**
+ * 피치 변경 보간 품질: 사인파를 rate배로 재생한 결과와 정확한 사인파의 SNR (dB)
+ */
+double interpolationSnr(RenderKernels::Interpolation interpolation, double rate, double frequency) {
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int LENGTH = 48000;
+    const double pi = juce::MathConstants<double>::pi;
+
+    juce::AudioBuffer<float> source(1, LENGTH);
+    for (int i = 0; i < LENGTH; ++i) {
+        source.setSample(0, i, static_cast<float>(std::sin(2.0 * pi * frequency * i / SAMPLE_RATE)));
+    }
+
+    const int frames = static_cast<int>((LENGTH - 64) / rate);
+    juce::AudioBuffer<float> out(1, frames);
+    out.clear();
+    float* outPtr = out.getWritePointer(0);
+    const float* srcPtr = source.getReadPointer(0);
+    RenderKernels::mixResampled(interpolation, &outPtr, 1, &srcPtr, 1, LENGTH, 0.0, rate, frames, 1.0f, 0.0f);
+
+    double signal = 0.0, noise = 0.0;
+    for (int i = 32; i < frames - 32; ++i) {
+        const double expected = std::sin(2.0 * pi * frequency * i * rate / SAMPLE_RATE);
+        signal += expected * expected;
+        noise += (outPtr[i] - expected) * (outPtr[i] - expected);
+    }
+    return 10.0 * std::log10(signal / std::max(noise, 1.0e-30));
+}
+
+/**
+ * 보간 방식별 보이스당 비용 (스테레오 소스, 반음 위로 재생)
+ */
+void runInterpolationBench(int blockSize, int frames, const RenderKernels::Isa* isas, int numIsas) {
+    constexpr int SOURCE_LENGTH = 1 << 16;
+    constexpr double RATE = 1.0594630943592953;  // 반음 위
+    const auto source = makeSource(2, SOURCE_LENGTH + 1024);
+    const int maxOffset = static_cast<int>((SOURCE_LENGTH - 2 * blockSize) / RATE);
+    const int iterations = std::max(100, frames / blockSize);
+    juce::AudioBuffer<float> out(2, blockSize);
+    float* outPtrs[2] = { out.getWritePointer(0), out.getWritePointer(1) };
+    const float* srcPtrs[2] = { source.getReadPointer(0), source.getReadPointer(1) };
+
+    std::cout << "\nPitched playback (stereo, +1 semitone), ns per output frame / us per voice per "
+              << blockSize << "-frame block" << std::endl;
+    std::cout << "interp  ";
+    for (int k = 0; k < numIsas; ++k) {
+        if (RenderKernels::isSupported(isas[k])) {
+            std::cout << juce::String(RenderKernels::getIsaName(isas[k])).paddedLeft(' ', 16);
+        }
+    }
+    std::cout << "   SNR 1k / 10k" << std::endl;
+
+    for (auto interpolation : { RenderKernels::Interpolation::Linear, RenderKernels::Interpolation::Cubic,
+                                RenderKernels::Interpolation::Sinc }) {
+        juce::String line = juce::String(RenderKernels::getInterpolationName(interpolation)).paddedRight(' ', 8);
+        for (int k = 0; k < numIsas; ++k) {
+            if (!RenderKernels::setIsa(isas[k])) continue;
+            out.clear();
+            const double ns = timePerFrameNs(blockSize, iterations, maxOffset, [&](int offset) {
+                RenderKernels::mixResampled(interpolation, outPtrs, 2, srcPtrs, 2, SOURCE_LENGTH,
+                                            offset * RATE + 0.25, RATE, blockSize, 0.5f, 0.0f);
+            });
+            line << (juce::String(ns, 2) + " / " + juce::String(ns * blockSize / 1000.0, 2)).paddedLeft(' ', 16);
+        }
+        line << (juce::String(interpolationSnr(interpolation, RATE, 1000.0), 1) + " / " +
+                 juce::String(interpolationSnr(interpolation, RATE, 10000.0), 1) + " dB").paddedLeft(' ', 18);
+        std::cout << line << std::endl;
+    }
+}
+
+} // namespace
+
+int runKernelBench(const juce::StringArray& args) {
+    auto blockSizes = parseIntList(getOption(args, "--buffers", "16,64,256,1024"));
+    int frames = std::max(100000, getOption(args, "--frames", "4000000").getIntValue());
+    if (blockSizes.empty()) {
+        std::cerr << "Invalid --buffers" << std::endl;
+        return 1;
+    }
+
+    const RenderKernels::Isa isas[] = { RenderKernels::Isa::Scalar, RenderKernels::Isa::SSE2,
+                                        RenderKernels::Isa::AVX2, RenderKernels::Isa::NEON };
+    const RenderKernels::Isa defaultIsa = RenderKernels::getIsa();
+    constexpr int SOURCE_LENGTH = 1 << 16;  // L2에 들어가는 크기 (캐시 미스가 아닌 연산 비용 측정)
+
+    std::cout << "Voice render kernel, ns per output frame (lower is better), default "
+              << RenderKernels::getIsaName(defaultIsa) << std::endl;
+
+    int exitCode = 0;
+    for (int srcChannels : { 1, 2 }) {
+        const auto source = makeSource(srcChannels, SOURCE_LENGTH + 1024);
+        std::cout << "\n" << (srcChannels == 1 ? "mono -> stereo" : "stereo -> stereo") << std::endl;
+        std::cout << "buffer    legacy";
+        for (auto isa : isas) {
+            if (RenderKernels::isSupported(isa)) {
+                std::cout << juce::String(RenderKernels::getIsaName(isa)).paddedLeft(' ', 10);
+            }
+        }
+        std::cout << "   speedup  max diff" << std::endl;
+
+        for (int blockSize : blockSizes) {
+            if (blockSize <= 0) continue;
+            juce::AudioBuffer<float> out(2, blockSize);
+            juce::AudioBuffer<float> reference(2, blockSize);
+            const int blockIterations = std::max(100, frames / blockSize);
+
+            out.clear();
+            double legacyNs = timePerFrameNs(blockSize, blockIterations, SOURCE_LENGTH, [&](int offset) {
+                legacyRender(source, out, offset, blockSize, 0.5f);
+            });
+
+            juce::String line = juce::String(blockSize).paddedLeft(' ', 6) + juce::String(legacyNs, 3).paddedLeft(' ', 10);
+            double bestNs = legacyNs;
+            float maxDiff = 0.0f;
+
+            for (auto isa : isas) {
+                if (!RenderKernels::setIsa(isa)) continue;
+
+                float* outPtrs[2] = { out.getWritePointer(0), out.getWritePointer(1) };
+                out.clear();
+                double ns = timePerFrameNs(blockSize, blockIterations, SOURCE_LENGTH, [&](int offset) {
+                    const float* srcPtrs[2] = { source.getReadPointer(0, offset),
+                                                source.getReadPointer(srcChannels - 1, offset) };
+                    RenderKernels::mixUnitStep(outPtrs, 2, srcPtrs, srcChannels, blockSize, 0.5f, 0.0f);
+                });
+                line << juce::String(ns, 3).paddedLeft(' ', 10);
+                bestNs = std::min(bestNs, ns);
+
+                // 같은 입력에서 결과 비교
+                reference.clear();
+                out.clear();
+                legacyRender(source, reference, 100, blockSize, 0.5f);
+                const float* srcPtrs[2] = { source.getReadPointer(0, 100), source.getReadPointer(srcChannels - 1, 100) };
+                RenderKernels::mixUnitStep(outPtrs, 2, srcPtrs, srcChannels, blockSize, 0.5f, 0.0f);
+                for (int ch = 0; ch < 2; ++ch) {
+                    for (int i = 0; i < blockSize; ++i) {
+                        maxDiff = std::max(maxDiff, std::abs(out.getSample(ch, i) - reference.getSample(ch, i)));
+                    }
+                }
+            }
+
+            line << juce::String(legacyNs / bestNs, 2).paddedLeft(' ', 9) << "x"
+                 << juce::String(maxDiff, 7).paddedLeft(' ', 10);
+            std::cout << line << std::endl;
+            if (maxDiff > 1.0e-6f) exitCode = 1;
+        }
+    }
+
+    runInterpolationBench(juce::jlimit(16, 4096, getOption(args, "--voice-buffer", "128").getIntValue()),
+                          frames, isas, static_cast<int>(std::size(isas)));
+
+    RenderKernels::setIsa(defaultIsa);
+    std::cout << "\nspeedup = legacy / fastest kernel. Legacy is the per-sample loop the kernels replaced." << std::endl;
+    return exitCode;
+}
+
+} // namespace Bench
+} // namespace FXBoard
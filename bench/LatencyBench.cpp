@@ -0,0 +1,306 @@
+#include "Bench.h"
+#include "CaptureDevice.h"
+#include "audio/AudioEngine.h"
+#include "core/Clock.h"
+#include "core/RtLog.h"
+#include "input/KeyHook.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#if JUCE_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/uinput.h>
+#include <cstring>
+#endif
+
+namespace FXBoard {
+namespace Bench {
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr uint32_t BENCH_KEY = 30;           // KEY_A
+constexpr float ONSET_THRESHOLD = 0.1f;
+constexpr int REARM_SILENCE_SAMPLES = 96;    // 2ms 무음 후 다음 onset 감지
+
+#if JUCE_LINUX
+/**
+ * uinput 가상 키보드
+ * KeyHook이 실제 키보드와 같은 evdev 경로로 읽음
+ */
+class VirtualKeyboard {
+public:
+    ~VirtualKeyboard() {
+        if (fd >= 0) {
+            ioctl(fd, UI_DEV_DESTROY);
+            close(fd);
+        }
+    }
+    
+    bool create() {
+        fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            std::cerr << "Cannot open /dev/uinput: " << strerror(errno)
+                      << " (run as root or add a udev rule for uinput)" << std::endl;
+            return false;
+        }
+        
+        ioctl(fd, UI_SET_EVBIT, EV_KEY);
+        ioctl(fd, UI_SET_EVBIT, EV_SYN);
+        // KeyHook 점수 기준(문자 키 + Space/Enter)을 넘도록 키 비트 설정
+        for (int code = KEY_Q; code <= KEY_P; ++code) ioctl(fd, UI_SET_KEYBIT, code);
+        for (int code = KEY_A; code <= KEY_L; ++code) ioctl(fd, UI_SET_KEYBIT, code);
+        for (int code = KEY_Z; code <= KEY_M; ++code) ioctl(fd, UI_SET_KEYBIT, code);
+        ioctl(fd, UI_SET_KEYBIT, KEY_SPACE);
+        ioctl(fd, UI_SET_KEYBIT, KEY_ENTER);
+        
+        struct uinput_setup setup;
+        std::memset(&setup, 0, sizeof(setup));
+        setup.id.bustype = BUS_VIRTUAL;
+        setup.id.vendor = 0x1209;
+        setup.id.product = 0xFB01;
+        std::strncpy(setup.name, "FXBoard Bench Keyboard", UINPUT_MAX_NAME_SIZE - 1);
+        
+        if (ioctl(fd, UI_DEV_SETUP, &setup) < 0 || ioctl(fd, UI_DEV_CREATE) < 0) {
+            std::cerr << "uinput device setup failed: " << strerror(errno) << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+    /**
+     * 키 누름 (SYN_REPORT까지), 쓰기 직전 시각 반환
+     */
+    uint64_t press(int code) {
+        uint64_t now = monotonicNowNs();
+        emit(EV_KEY, code, 1);
+        emit(EV_SYN, SYN_REPORT, 0);
+        return now;
+    }
+    
+    void release(int code) {
+        emit(EV_KEY, code, 0);
+        emit(EV_SYN, SYN_REPORT, 0);
+    }
+    
+private:
+    void emit(int type, int code, int value) {
+        struct input_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.type = static_cast<__u16>(type);
+        ev.code = static_cast<__u16>(code);
+        ev.value = value;
+        if (write(fd, &ev, sizeof(ev)) != static_cast<ssize_t>(sizeof(ev))) {
+            std::cerr << "uinput write failed: " << strerror(errno) << std::endl;
+        }
+    }
+    
+    int fd = -1;
+};
+#endif
+
+/**
+ * 출력 신호에서 클릭 시작점 검출 (디바이스 스레드 전용)
+ */
+class OnsetDetector {
+public:
+    explicit OnsetDetector(size_t maxOnsets) { onsets.reserve(maxOnsets); }
+    
+    void process(const float* const* output, int numSamples, uint64_t playbackNs) {
+        const double nsPerSample = 1.0e9 / SAMPLE_RATE;
+        for (int i = 0; i < numSamples; ++i) {
+            if (std::abs(output[0][i]) > ONSET_THRESHOLD) {
+                if (silentSamples >= REARM_SILENCE_SAMPLES && onsets.size() < onsets.capacity()) {
+                    onsets.push_back(playbackNs + static_cast<uint64_t>(i * nsPerSample));
+                }
+                silentSamples = 0;
+            } else {
+                ++silentSamples;
+            }
+        }
+    }
+    
+    const std::vector<uint64_t>& getOnsets() const { return onsets; }
+    
+private:
+    std::vector<uint64_t> onsets;
+    int silentSamples = REARM_SILENCE_SAMPLES;
+};
+
+/**
+ * 5ms 직류 클릭 (검출이 쉬운 급격한 시작)
+ */
+juce::AudioBuffer<float> makeClick() {
+    const int length = static_cast<int>(SAMPLE_RATE * 0.005);
+    juce::AudioBuffer<float> click(2, length);
+    for (int ch = 0; ch < 2; ++ch) {
+        for (int i = 0; i < length; ++i) {
+            click.setSample(ch, i, 0.8f);
+        }
+    }
+    return click;
+}
+
+struct RunResult {
+    int bufferSize = 0;
+    size_t presses = 0;
+    size_t onsets = 0;
+    std::vector<double> latenciesMs;  // 정렬됨
+    uint64_t engineTotalP50Us = 0;
+    uint64_t engineTotalP99Us = 0;
+    int lateCallbacks = 0;
+};
+
+#if JUCE_LINUX
+bool runOne(VirtualKeyboard& keyboard, int bufferSize, int presses, int intervalMs,
+            bool realtime, RunResult& result) {
+    AudioEngine engine;
+    engine.prepareToPlay(SAMPLE_RATE);
+    engine.getSampleManager().addSample("bench_click", makeClick(), SAMPLE_RATE);
+    engine.getSampleManager().packSamples();
+    engine.mapKeyToSample(BENCH_KEY, "bench_click");
+    
+    KeyHook hook(engine.getEventQueue());
+    CaptureDevice device(SAMPLE_RATE, bufferSize);
+    if (realtime) {
+        hook.setRealtime(85, -1);
+        device.setRealtimePriority(80);
+    }
+    
+    OnsetDetector detector(static_cast<size_t>(presses) * 2);
+    device.setBlockObserver([&detector](const float* const* output, int, int numSamples, uint64_t playbackNs) {
+        detector.process(output, numSamples, playbackNs);
+    });
+    
+    if (!hook.start()) {
+        std::cerr << "KeyHook failed to start (no readable input devices?)" << std::endl;
+        return false;
+    }
+    device.start(&engine);
+    
+    // 오디오 클럭 DLL 수렴 대기
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    
+    // 간격에 무작위 성분을 넣어 키 입력이 블록 내 임의 위치에 떨어지게 함
+    std::mt19937 rng(static_cast<unsigned>(bufferSize));
+    std::uniform_int_distribution<int> jitterUs(0, intervalMs * 500);
+    std::vector<uint64_t> injected;
+    injected.reserve(static_cast<size_t>(presses));
+    
+    for (int i = 0; i < presses; ++i) {
+        injected.push_back(keyboard.press(KEY_A));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        keyboard.release(KEY_A);
+        std::this_thread::sleep_for(std::chrono::microseconds(intervalMs * 1000 - 10000 + jitterUs(rng)));
+    }
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    device.stop();
+    hook.stop();
+    
+    const auto& onsets = detector.getOnsets();
+    result.bufferSize = bufferSize;
+    result.presses = injected.size();
+    result.onsets = onsets.size();
+    result.lateCallbacks = device.getLateCallbacks();
+    
+    // 각 입력 이후 첫 onset과 짝지음 (누락된 onset은 건너뜀)
+    size_t next = 0;
+    for (size_t i = 0; i < injected.size(); ++i) {
+        uint64_t limit = (i + 1 < injected.size()) ? injected[i + 1] : UINT64_MAX;
+        while (next < onsets.size() && onsets[next] < injected[i]) ++next;
+        if (next < onsets.size() && onsets[next] < limit) {
+            result.latenciesMs.push_back(static_cast<double>(onsets[next] - injected[i]) / 1.0e6);
+            ++next;
+        }
+    }
+    std::sort(result.latenciesMs.begin(), result.latenciesMs.end());
+    
+    const auto& total = engine.getLatencyHistogram(AudioEngine::LatencyTotal);
+    result.engineTotalP50Us = total.getPercentileUs(0.50);
+    result.engineTotalP99Us = total.getPercentileUs(0.99);
+    return true;
+}
+#endif
+
+juce::String ms(double value) {
+    return juce::String(value, 2).paddedLeft(' ', 8);
+}
+
+} // namespace
+
+int runLatencyBench(const juce::StringArray& args) {
+#if JUCE_LINUX
+    auto bufferSizes = parseIntList(getOption(args, "--buffers", "32,64,128,256"));
+    int presses = getOption(args, "--presses", "200").getIntValue();
+    int intervalMs = std::max(20, getOption(args, "--interval-ms", "40").getIntValue());
+    bool realtime = hasFlag(args, "--rt");
+    
+    if (bufferSizes.empty() || presses <= 0) {
+        std::cerr << "Invalid --buffers or --presses" << std::endl;
+        return 1;
+    }
+    
+    RtLog::start();
+    
+    VirtualKeyboard keyboard;
+    if (!keyboard.create()) {
+        RtLog::stop();
+        return 1;
+    }
+    // udev가 /dev/input/eventN 노드를 만들고 권한을 설정할 때까지 대기
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    
+    std::cout << "Key-to-onset latency, " << presses << " presses per buffer size, "
+              << SAMPLE_RATE / 1000.0 << " kHz" << (realtime ? ", SCHED_FIFO" : "") << std::endl;
+    std::cout << "(do not type on other keyboards while the benchmark runs)" << std::endl;
+    std::cout << "\nbuffer  detected     min     p50     p99     max  jitter  engine p50/p99  late cb" << std::endl;
+    
+    int exitCode = 0;
+    for (int bufferSize : bufferSizes) {
+        RunResult result;
+        if (!runOne(keyboard, bufferSize, presses, intervalMs, realtime, result)) {
+            exitCode = 1;
+            break;
+        }
+        
+        const auto& lat = result.latenciesMs;
+        juce::String line = juce::String(bufferSize).paddedLeft(' ', 6)
+                          + juce::String(juce::String(lat.size()) + "/" + juce::String(result.presses)).paddedLeft(' ', 10);
+        if (lat.empty()) {
+            line << "  (no onsets detected)";
+            exitCode = 1;
+        } else {
+            line << ms(lat.front()) << ms(percentile(lat, 0.50)) << ms(percentile(lat, 0.99)) << ms(lat.back())
+                 << ms(percentile(lat, 0.99) - percentile(lat, 0.01))
+                 << juce::String(juce::String(result.engineTotalP50Us / 1000.0, 2) + "/"
+                                 + juce::String(result.engineTotalP99Us / 1000.0, 2)).paddedLeft(' ', 16);
+        }
+        line << juce::String(result.lateCallbacks).paddedLeft(' ', 9);
+        std::cout << line << std::endl;
+        
+        if (result.onsets != lat.size()) {
+            std::cout << "        " << (result.onsets - lat.size()) << " unmatched onsets (other keyboard input?)" << std::endl;
+        }
+    }
+    
+    std::cout << "\nLatency in ms from uinput write to first output sample above threshold." << std::endl;
+    std::cout << "Engine column is AudioEngine's own LatencyTotal estimate for comparison." << std::endl;
+    
+    RtLog::stop();
+    return exitCode;
+#else
+    juce::ignoreUnused(args);
+    std::cerr << "The latency benchmark requires Linux (uinput + evdev)" << std::endl;
+    return 1;
+#endif
+}
+
+} // namespace Bench
+} // namespace FXBoard
@@ -0,0 +1,277 @@
+#include "Bench.h"
+#include "audio/FX.h"
+#include "audio/SampleManager.h"
+#include "audio/VoiceRenderPool.h"
+#include "core/Realtime.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#if JUCE_LINUX
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace FXBoard {
+namespace Bench {
+
+namespace {
+
+constexpr double SAMPLE_RATE = 48000.0;
+constexpr int WARMUP_BLOCKS = 100;
+
+/**
+ * 긴 잔향 꼬리를 흉내 낸 샘플 (지수 감쇠 노이즈, 측정 내내 보이스가 살아 있도록 충분히 길게)
+ * int16이면 16비트 값으로 양자화해 pcm에 담고 Sample::compact가 가리킴 (packSamples()와 같은 배치)
+ */
+struct Tail {
+    Sample sample;
+    std::vector<int16_t> pcm;
+};
+
+void makeTail(Tail& tail, int index, int length, bool compact) {
+    Sample& sample = tail.sample;
+    sample.id = "bench_tail" + juce::String(index);
+    sample.sampleRate = SAMPLE_RATE;
+    sample.buffer.setSize(2, length);
+
+    std::mt19937 rng(static_cast<unsigned>(index + 1));
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    const float decayPerSample = std::pow(0.001f, 1.0f / static_cast<float>(length));
+    for (int ch = 0; ch < 2; ++ch) {
+        float envelope = 0.5f;
+        for (int i = 0; i < length; ++i) {
+            const float value = noise(rng) * envelope;
+            sample.buffer.setSample(ch, i, compact ? std::round(value * 32768.0f) / 32768.0f : value);
+            envelope *= decayPerSample;
+        }
+    }
+    if (!compact) return;
+
+    // 채널마다 끝 뒤에 0인 여유 샘플 하나
+    const size_t stride = static_cast<size_t>(length) + 1;
+    tail.pcm.assign(stride * 2, 0);
+    for (int ch = 0; ch < 2; ++ch) {
+        int16_t* out = tail.pcm.data() + static_cast<size_t>(ch) * stride;
+        const float* in = sample.buffer.getReadPointer(ch);
+        for (int i = 0; i < length; ++i) {
+            out[i] = static_cast<int16_t>(juce::jlimit(-32768.0f, 32767.0f, in[i] * 32768.0f));
+        }
+        sample.compact.channels[ch] = out;
+    }
+    sample.compact.numChannels = 2;
+    sample.compact.numFrames = length;
+    sample.buffer = juce::AudioBuffer<float>();
+}
+
+/**
+ * 이 스레드의 캐시 미스 수 (perf_event_open, 리눅스가 아니거나 권한이 없으면 사용 불가)
+ * perf_event_paranoid가 높으면 `sudo sysctl kernel.perf_event_paranoid=1`
+ */
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#if JUCE_LINUX
+        perf_event_attr attr {};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter() {
+#if JUCE_LINUX
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    bool isAvailable() const { return fd >= 0; }
+
+    void start() {
+#if JUCE_LINUX
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    uint64_t stop() {
+        uint64_t count = 0;
+#if JUCE_LINUX
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) return 0;
+#endif
+        return count;
+    }
+
+private:
+    int fd = -1;
+};
+
+struct BlockTimes {
+    double meanUs = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    double missesPerBlock = -1.0;  // 음수 = 측정 불가 (병렬 렌더링은 워커 스레드를 세지 않으므로 직렬만)
+};
+
+/**
+ * numVoices개 보이스를 bufferSize 블록으로 numBlocks번 렌더링하며 블록별 시간 측정
+ * @param pool nullptr = 직렬 렌더링
+ */
+BlockTimes runOne(const std::vector<Tail>& tails, int numVoices, int bufferSize, int numBlocks,
+                  bool withReverb, VoiceRenderPool* pool) {
+    SamplePlayer player(numVoices);
+    player.setRenderPool(pool, 2);
+    for (int i = 0; i < numVoices; ++i) {
+        player.trigger(&tails[static_cast<size_t>(i) % tails.size()].sample, 0.5f, i % bufferSize);
+    }
+    CacheMissCounter misses;
+
+    SimpleReverb reverb;
+    reverb.setup(SAMPLE_RATE);
+    reverb.setMix(0.3f);
+    reverb.setDecay(0.7f);
+
+    juce::AudioBuffer<float> block(2, bufferSize);
+    std::vector<double> times;
+    times.reserve(static_cast<size_t>(numBlocks));
+
+    for (int b = 0; b < WARMUP_BLOCKS + numBlocks; ++b) {
+        if (b == WARMUP_BLOCKS && pool == nullptr) {
+            misses.start();
+        }
+        auto start = std::chrono::steady_clock::now();
+
+        block.clear();
+        player.renderNextBlock(block, 0, bufferSize);
+        if (withReverb) {
+            for (int ch = 0; ch < 2; ++ch) {
+                auto* data = block.getWritePointer(ch);
+                for (int i = 0; i < bufferSize; ++i) {
+                    data[i] = reverb.process(data[i]);
+                }
+            }
+        }
+
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (b >= WARMUP_BLOCKS) {
+            times.push_back(elapsed);
+        }
+    }
+
+    const uint64_t missCount = misses.stop();
+    std::sort(times.begin(), times.end());
+    BlockTimes result;
+    if (pool == nullptr && misses.isAvailable()) {
+        result.missesPerBlock = static_cast<double>(missCount) / static_cast<double>(numBlocks);
+    }
+    for (double t : times) result.meanUs += t;
+    result.meanUs /= static_cast<double>(times.size());
+    result.p99Us = percentile(times, 0.99);
+    result.maxUs = times.back();
+    return result;
+}
+
+juce::String us(double value) {
+    return juce::String(value, 1).paddedLeft(' ', 8);
+}
+
+} // namespace
+
+int runVoiceBench(const juce::StringArray& args) {
+    auto voiceCounts = parseIntList(getOption(args, "--voices", "8,16,24,32,48,64,96,128,192,256"));
+    int bufferSize = juce::jlimit(16, VoiceRenderPool::MAX_BLOCK_SIZE, getOption(args, "--buffer", "64").getIntValue());
+    int numBlocks = std::max(100, getOption(args, "--blocks", "3000").getIntValue());
+    int defaultThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    int numThreads = juce::jlimit(1, VoiceRenderPool::MAX_WORKERS,
+                                  getOption(args, "--threads", juce::String(defaultThreads)).getIntValue());
+    int firstCpu = getOption(args, "--cpu", "-1").getIntValue();
+    bool withReverb = !hasFlag(args, "--no-reverb");
+    bool realtime = hasFlag(args, "--rt");
+    int numSamples = juce::jlimit(1, 256, getOption(args, "--samples", "1").getIntValue());
+    juce::String format = getOption(args, "--format", "float");
+
+    if (voiceCounts.empty()) {
+        std::cerr << "Invalid --voices" << std::endl;
+        return 1;
+    }
+    if (format != "float" && format != "int16") {
+        std::cerr << "Invalid --format (float or int16)" << std::endl;
+        return 1;
+    }
+
+    // 오디오 콜백 스레드 역할: 워커 앞 코어에 고정
+    const int priority = realtime ? 80 : 0;
+    if (realtime) {
+        Realtime::configureCurrentThread(priority, firstCpu, "Bench");
+    }
+
+    VoiceRenderPool pool;
+    if (!pool.start(numThreads, 2, priority, firstCpu >= 0 ? firstCpu + 1 : -1)) {
+        std::cerr << "Failed to start render workers" << std::endl;
+        return 1;
+    }
+
+    // 보이스는 샘플들을 돌아가며 재생 (샘플 수가 많을수록 캐시에 들어가지 않는 작업 집합)
+    const int tailLength = (WARMUP_BLOCKS + numBlocks + 1) * bufferSize;
+    std::vector<Tail> tails(static_cast<size_t>(numSamples));
+    for (int i = 0; i < numSamples; ++i) {
+        makeTail(tails[static_cast<size_t>(i)], i, tailLength, format == "int16");
+    }
+    const double sampleMb = static_cast<double>(tailLength) * 2.0 * (format == "int16" ? 2.0 : 4.0) *
+                            numSamples / (1024.0 * 1024.0);
+    const double deadlineUs = bufferSize / SAMPLE_RATE * 1.0e6;
+
+    std::cout << "Voice render time per " << bufferSize << "-sample block (deadline "
+              << juce::String(deadlineUs, 0) << " us), " << numThreads << " workers + callback thread"
+              << (withReverb ? ", reverb on" : "") << (realtime ? ", SCHED_FIFO" : "") << std::endl;
+    std::cout << numSamples << " sample(s) as " << format << " (" << juce::String(sampleMb, 1) << " MB)" << std::endl;
+    std::cout << "\nvoices   serial mean/p99/max (us)   parallel mean/p99/max (us)   p99 speedup  load  misses/block" << std::endl;
+
+    int crossover = -1;
+    for (int voices : voiceCounts) {
+        if (voices <= 0) continue;
+
+        BlockTimes serial = runOne(tails, voices, bufferSize, numBlocks, withReverb, nullptr);
+        BlockTimes parallel = runOne(tails, voices, bufferSize, numBlocks, withReverb, &pool);
+
+        const double speedup = parallel.p99Us > 0.0 ? serial.p99Us / parallel.p99Us : 0.0;
+        if (crossover < 0 && speedup > 1.0) {
+            crossover = voices;
+        }
+
+        std::cout << juce::String(voices).paddedLeft(' ', 6) << "  "
+                  << us(serial.meanUs) << us(serial.p99Us) << us(serial.maxUs) << "    "
+                  << us(parallel.meanUs) << us(parallel.p99Us) << us(parallel.maxUs) << "   "
+                  << juce::String(speedup, 2).paddedLeft(' ', 9) << "x"
+                  << juce::String(juce::String(juce::roundToInt(100.0 * std::min(serial.p99Us, parallel.p99Us) / deadlineUs)) + "%").paddedLeft(' ', 6)
+                  << (serial.missesPerBlock >= 0.0 ? juce::String(serial.missesPerBlock, 0) : juce::String("n/a")).paddedLeft(' ', 14)
+                  << std::endl;
+    }
+
+    pool.stop();
+
+    std::cout << "\nload = faster p99 as a share of the block deadline." << std::endl;
+    std::cout << "misses/block = hardware cache misses of the serial run (perf_event_open, n/a if not permitted)." << std::endl;
+    if (crossover > 0) {
+        std::cout << "Parallel rendering wins from " << crossover << " voices: set audio.parallelMinVoices to about "
+                  << crossover << std::endl;
+    } else {
+        std::cout << "Parallel rendering did not beat serial rendering at these voice counts" << std::endl;
+    }
+    return 0;
+}
+
+} // namespace Bench
+} // namespace FXBoard
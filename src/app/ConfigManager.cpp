@@ -1,4 +1,5 @@
 #include "ConfigManager.h"
+#include <utility>
 
 namespace FXBoard {
 
@@ -21,27 +22,30 @@ bool ConfigManager::loadConfig(const juce::File& configFile) {
     // JSON을 ValueTree로 변환
     config = juce::ValueTree("FXBoardConfig");
     
-    // 기본 설정 파싱
-    if (json.hasProperty("audio")) {
-        auto audioTree = juce::ValueTree("Audio");
-        auto* audioObj = json.getProperty("audio", juce::var()).getDynamicObject();
-        if (audioObj != nullptr) {
-            for (auto& prop : audioObj->getProperties()) {
-                audioTree.setProperty(prop.name, prop.value, nullptr);
-            }
-        }
-        config.appendChild(audioTree, nullptr);
-    }
+    // 섹션 파싱 (JSON 객체 → 같은 속성의 ValueTree 자식)
+    static const std::pair<const char*, const char*> sections[] = {
+        {"audio",       "Audio"},
+        {"keymapping",  "KeyMapping"},
+        {"keytuning",   "KeyTuning"},
+        {"realtime",    "Realtime"},
+        {"midi",        "Midi"},
+        {"midimapping", "MidiMapping"},
+        {"samples",     "Samples"},
+    };
     
-    if (json.hasProperty("keymapping")) {
-        auto keyTree = juce::ValueTree("KeyMapping");
-        auto* keyObj = json.getProperty("keymapping", juce::var()).getDynamicObject();
-        if (keyObj != nullptr) {
-            for (auto& prop : keyObj->getProperties()) {
-                keyTree.setProperty(prop.name, prop.value, nullptr);
+    for (const auto& [jsonName, treeName] : sections) {
+        if (!json.hasProperty(jsonName)) {
+            continue;
+        }
+        
+        auto sectionTree = juce::ValueTree(treeName);
+        auto* sectionObj = json.getProperty(jsonName, juce::var()).getDynamicObject();
+        if (sectionObj != nullptr) {
+            for (auto& prop : sectionObj->getProperties()) {
+                sectionTree.setProperty(prop.name, prop.value, nullptr);
             }
         }
-        config.appendChild(keyTree, nullptr);
+        config.appendChild(sectionTree, nullptr);
     }
     
     juce::Logger::writeToLog("Config loaded from: " + configFile.getFullPathName());
@@ -79,6 +83,15 @@ juce::var ConfigManager::getProperty(const juce::Identifier& name, const juce::v
     return config.getProperty(name, defaultValue);
 }
 
+juce::var ConfigManager::getSectionProperty(const juce::Identifier& section, const juce::Identifier& name,
+                                            const juce::var& defaultValue) const {
+    auto tree = config.getChildWithName(section);
+    if (!tree.isValid()) {
+        return defaultValue;
+    }
+    return tree.getProperty(name, defaultValue);
+}
+
 void ConfigManager::setProperty(const juce::Identifier& name, const juce::var& value) {
     config.setProperty(name, value, nullptr);
 }
@@ -26,6 +26,12 @@ public:
      */
     juce::var getProperty(const juce::Identifier& name, const juce::var& defaultValue = juce::var()) const;
     
+    /**
+     * 섹션 설정 값 가져오기 (예: "Audio", "Realtime", "Midi")
+     */
+    juce::var getSectionProperty(const juce::Identifier& section, const juce::Identifier& name,
+                                 const juce::var& defaultValue = juce::var()) const;
+    
     /**
      * 설정 값 설정
      */
@@ -0,0 +1,326 @@
+#include "AlsaOutputDevice.h"
+#include "../core/Clock.h"
+#include "../core/RtLog.h"
+#include <limits>
+#include <type_traits>
+
+#if JUCE_LINUX
+#include <alsa/asoundlib.h>
+#include <cerrno>
+#endif
+
+namespace FXBoard {
+
+namespace {
+
+template <typename T>
+T convertSample(float sample) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return juce::jlimit(-1.0f, 1.0f, sample);
+    } else {
+        constexpr double scale = static_cast<double>(std::numeric_limits<T>::max());
+        return static_cast<T>(juce::jlimit(-1.0f, 1.0f, sample) * scale);
+    }
+}
+
+/**
+ * 채널별 버퍼 [start, start + frames) → 인터리브 mmap 영역
+ */
+template <typename T>
+void interleave(const std::vector<std::vector<float>>& channels, size_t start, size_t frames, void* dest) {
+    auto* out = static_cast<T*>(dest);
+    const size_t numChannels = channels.size();
+    for (size_t f = 0; f < frames; ++f) {
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            out[f * numChannels + ch] = convertSample<T>(channels[ch][start + f]);
+        }
+    }
+}
+
+} // namespace
+
+AlsaOutputDevice::AlsaOutputDevice(const juce::String& deviceName, int frames, int periods)
+    : juce::AudioIODevice(deviceName, "ALSA (direct)"),
+      pcmName(deviceName),
+      periodSize(juce::jmax(32, frames)),
+      numPeriods(juce::jmax(2, periods)) {
+}
+
+AlsaOutputDevice::~AlsaOutputDevice() {
+    close();
+}
+
+juce::StringArray AlsaOutputDevice::getOutputChannelNames() {
+    juce::StringArray names;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        names.add("Out " + juce::String(ch + 1));
+    }
+    return names;
+}
+
+juce::BigInteger AlsaOutputDevice::getActiveOutputChannels() const {
+    juce::BigInteger channels;
+    channels.setRange(0, numChannels, true);
+    return channels;
+}
+
+#if JUCE_LINUX
+
+juce::String AlsaOutputDevice::open(const juce::BigInteger&, const juce::BigInteger& outputChannels,
+                                    double requestedSampleRate, int bufferSizeSamples) {
+    close();
+    
+    if (bufferSizeSamples > 0) {
+        periodSize = juce::jmax(32, bufferSizeSamples);
+    }
+    
+    auto fail = [this](const juce::String& what, int err) {
+        lastError = what + ": " + snd_strerror(err);
+        if (pcm != nullptr) {
+            snd_pcm_close(pcm);
+            pcm = nullptr;
+        }
+        return lastError;
+    };
+    
+    int err = snd_pcm_open(&pcm, pcmName.toRawUTF8(), SND_PCM_STREAM_PLAYBACK, 0);
+    if (err < 0) {
+        pcm = nullptr;
+        return fail("Cannot open " + pcmName, err);
+    }
+    
+    snd_pcm_hw_params_t* hw;
+    snd_pcm_hw_params_alloca(&hw);
+    snd_pcm_hw_params_any(pcm, hw);
+    
+    if ((err = snd_pcm_hw_params_set_access(pcm, hw, SND_PCM_ACCESS_MMAP_INTERLEAVED)) < 0) {
+        return fail("MMAP_INTERLEAVED not supported (try plughw:)", err);
+    }
+    
+    // 변환 없이 쓸 수 있는 포맷 우선
+    static const std::pair<snd_pcm_format_t, SampleFormat> formats[] = {
+        {SND_PCM_FORMAT_FLOAT_LE, SampleFormat::Float32},
+        {SND_PCM_FORMAT_S32_LE,   SampleFormat::Int32},
+        {SND_PCM_FORMAT_S16_LE,   SampleFormat::Int16},
+    };
+    bool formatSet = false;
+    for (const auto& [alsaFormat, sampleFormat] : formats) {
+        if (snd_pcm_hw_params_set_format(pcm, hw, alsaFormat) == 0) {
+            format = sampleFormat;
+            bitDepth = (sampleFormat == SampleFormat::Int16) ? 16 : 32;
+            formatSet = true;
+            break;
+        }
+    }
+    if (!formatSet) {
+        return fail("No supported sample format (float/S32/S16)", -EINVAL);
+    }
+    
+    unsigned int channels = static_cast<unsigned int>(juce::jmax(2, outputChannels.countNumberOfSetBits()));
+    unsigned int rate = static_cast<unsigned int>(requestedSampleRate > 0.0 ? requestedSampleRate : 48000.0);
+    snd_pcm_uframes_t period = static_cast<snd_pcm_uframes_t>(periodSize);
+    unsigned int periods = static_cast<unsigned int>(numPeriods);
+    
+    if ((err = snd_pcm_hw_params_set_channels_near(pcm, hw, &channels)) < 0) return fail("Channels", err);
+    if ((err = snd_pcm_hw_params_set_rate_resample(pcm, hw, 0)) < 0) return fail("Rate resample", err);
+    if ((err = snd_pcm_hw_params_set_rate_near(pcm, hw, &rate, nullptr)) < 0) return fail("Sample rate", err);
+    if ((err = snd_pcm_hw_params_set_period_size_near(pcm, hw, &period, nullptr)) < 0) return fail("Period size", err);
+    if ((err = snd_pcm_hw_params_set_periods_near(pcm, hw, &periods, nullptr)) < 0) return fail("Period count", err);
+    if ((err = snd_pcm_hw_params(pcm, hw)) < 0) return fail("hw_params", err);
+    
+    // 드라이버가 조정한 실제 값
+    snd_pcm_hw_params_get_period_size(hw, &period, nullptr);
+    snd_pcm_hw_params_get_periods(hw, &periods, nullptr);
+    numChannels = static_cast<int>(channels);
+    sampleRate = rate;
+    periodSize = static_cast<int>(period);
+    numPeriods = static_cast<int>(periods);
+    
+    // 시작은 prefill 후 직접, 주기 하나가 비면 깨어남
+    snd_pcm_sw_params_t* sw;
+    snd_pcm_sw_params_alloca(&sw);
+    snd_pcm_sw_params_current(pcm, sw);
+    snd_pcm_sw_params_set_start_threshold(pcm, sw, period * periods);
+    snd_pcm_sw_params_set_avail_min(pcm, sw, period);
+    if ((err = snd_pcm_sw_params(pcm, sw)) < 0) return fail("sw_params", err);
+    
+    channelData.assign(static_cast<size_t>(numChannels), std::vector<float>(static_cast<size_t>(periodSize)));
+    channelPointers.clear();
+    for (auto& channel : channelData) {
+        channelPointers.push_back(channel.data());
+    }
+    
+    juce::Logger::writeToLog("ALSA " + pcmName + ": " + juce::String(rate) + " Hz, " +
+                             juce::String(periodSize) + " frames x " + juce::String(numPeriods) + " periods, " +
+                             juce::String(bitDepth) + "-bit " + (format == SampleFormat::Float32 ? "float" : "int"));
+    lastError.clear();
+    return {};
+}
+
+void AlsaOutputDevice::close() {
+    stop();
+    if (pcm != nullptr) {
+        snd_pcm_close(pcm);
+        pcm = nullptr;
+    }
+}
+
+void AlsaOutputDevice::start(juce::AudioIODeviceCallback* newCallback) {
+    if (pcm == nullptr || newCallback == nullptr || running.load()) return;
+    
+    callback = newCallback;
+    callback->audioDeviceAboutToStart(this);
+    
+    xrunCount = 0;
+    minDelay = periodSize * numPeriods;
+    maxDelay = 0;
+    
+    if (!prefill()) {
+        callback->audioDeviceStopped();
+        callback = nullptr;
+        return;
+    }
+    
+    running = true;
+    thread = std::thread(&AlsaOutputDevice::run, this);
+}
+
+void AlsaOutputDevice::stop() {
+    if (!running.exchange(false)) return;
+    
+    if (thread.joinable()) {
+        thread.join();
+    }
+    snd_pcm_drop(pcm);
+    
+    if (callback != nullptr) {
+        callback->audioDeviceStopped();
+        callback = nullptr;
+    }
+}
+
+bool AlsaOutputDevice::prefill() {
+    int err = snd_pcm_prepare(pcm);
+    if (err < 0) {
+        lastError = juce::String("snd_pcm_prepare: ") + snd_strerror(err);
+        return false;
+    }
+    
+    // 링 버퍼 전체를 무음으로 채우고 시작 - 이후 주기마다 하나씩 채워 지연을 일정하게 유지
+    snd_pcm_sframes_t avail = snd_pcm_avail_update(pcm);
+    while (avail > 0) {
+        const snd_pcm_channel_area_t* areas;
+        snd_pcm_uframes_t offset;
+        snd_pcm_uframes_t frames = static_cast<snd_pcm_uframes_t>(avail);
+        if ((err = snd_pcm_mmap_begin(pcm, &areas, &offset, &frames)) < 0) break;
+        snd_pcm_areas_silence(areas, offset, static_cast<unsigned int>(numChannels), frames, snd_pcm_format(pcm));
+        snd_pcm_mmap_commit(pcm, offset, frames);
+        avail -= static_cast<snd_pcm_sframes_t>(frames);
+    }
+    
+    if ((err = snd_pcm_start(pcm)) < 0) {
+        lastError = juce::String("snd_pcm_start: ") + snd_strerror(err);
+        return false;
+    }
+    return true;
+}
+
+bool AlsaOutputDevice::writePeriod(uint64_t callbackNs) {
+    juce::AudioIODeviceCallbackContext context {};
+    context.hostTimeNs = &callbackNs;
+    callback->audioDeviceIOCallbackWithContext(nullptr, 0, channelPointers.data(),
+                                               numChannels, periodSize, context);
+    
+    snd_pcm_uframes_t done = 0;
+    const auto total = static_cast<snd_pcm_uframes_t>(periodSize);
+    
+    while (done < total) {
+        const snd_pcm_channel_area_t* areas;
+        snd_pcm_uframes_t offset;
+        snd_pcm_uframes_t frames = total - done;
+        
+        int err = snd_pcm_mmap_begin(pcm, &areas, &offset, &frames);
+        if (err < 0) return recover(err);
+        
+        // 인터리브: 모든 채널이 areas[0]에서 step 간격으로 배치
+        auto* base = static_cast<char*>(areas[0].addr) + (areas[0].first + offset * areas[0].step) / 8;
+        switch (format) {
+            case SampleFormat::Float32: interleave<float>(channelData, done, frames, base); break;
+            case SampleFormat::Int32:   interleave<int32_t>(channelData, done, frames, base); break;
+            case SampleFormat::Int16:   interleave<int16_t>(channelData, done, frames, base); break;
+        }
+        
+        snd_pcm_sframes_t committed = snd_pcm_mmap_commit(pcm, offset, frames);
+        if (committed < 0 || static_cast<snd_pcm_uframes_t>(committed) != frames) {
+            return recover(committed < 0 ? static_cast<int>(committed) : -EPIPE);
+        }
+        done += frames;
+    }
+    return true;
+}
+
+bool AlsaOutputDevice::recover(int err) {
+    if (err == -EPIPE) {
+        xrunCount.fetch_add(1, std::memory_order_relaxed);
+        RtLog::warning("ALSA underrun ({} total)", xrunCount.load(std::memory_order_relaxed));
+    }
+    if (snd_pcm_recover(pcm, err, 1) < 0) {
+        RtLog::error("ALSA recovery failed: {}", err);
+        return false;
+    }
+    return prefill();
+}
+
+void AlsaOutputDevice::updateDelay() {
+    snd_pcm_sframes_t delay = 0;
+    if (snd_pcm_delay(pcm, &delay) < 0) return;
+    
+    const int frames = static_cast<int>(delay);
+    currentDelay.store(frames, std::memory_order_relaxed);
+    if (frames < minDelay.load(std::memory_order_relaxed)) minDelay.store(frames, std::memory_order_relaxed);
+    if (frames > maxDelay.load(std::memory_order_relaxed)) maxDelay.store(frames, std::memory_order_relaxed);
+}
+
+void AlsaOutputDevice::run() {
+    while (running.load(std::memory_order_relaxed)) {
+        snd_pcm_sframes_t avail = snd_pcm_avail_update(pcm);
+        if (avail < 0) {
+            if (!recover(static_cast<int>(avail))) break;
+            continue;
+        }
+        
+        if (avail < periodSize) {
+            // 주기 하나가 빌 때까지 대기 (100ms 타임아웃 - stop() 확인용)
+            int err = snd_pcm_wait(pcm, 100);
+            if (err < 0 && !recover(err)) break;
+            continue;
+        }
+        
+        if (!writePeriod(monotonicNowNs())) break;
+        updateDelay();
+    }
+    
+    if (running.load()) {
+        RtLog::error("ALSA output thread stopped after an unrecoverable error");
+    }
+}
+
+#else
+
+juce::String AlsaOutputDevice::open(const juce::BigInteger&, const juce::BigInteger&, double, int) {
+    lastError = "ALSA output is only available on Linux";
+    return lastError;
+}
+
+void AlsaOutputDevice::close() {
+}
+
+void AlsaOutputDevice::start(juce::AudioIODeviceCallback*) {
+}
+
+void AlsaOutputDevice::stop() {
+}
+
+#endif
+
+} // namespace FXBoard
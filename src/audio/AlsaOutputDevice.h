@@ -0,0 +1,104 @@
+#pragma once
+#include <juce_audio_devices/juce_audio_devices.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if JUCE_LINUX
+typedef struct _snd_pcm snd_pcm_t;
+#endif
+
+namespace FXBoard {
+
+/**
+ * ALSA 직접 출력 디바이스 (MMAP_INTERLEAVED)
+ * JUCE 기본 ALSA 디바이스는 주기 수를 고를 수 없어 3주기 이상 버퍼링되므로,
+ * hw:/plughw:를 직접 열어 주기 크기(최소 32프레임)와 주기 수(최소 2)를 지정
+ *
+ * 자체 스레드에서 AudioIODeviceCallback을 주기 단위로 호출하고 결과를 mmap 영역에 직접 씀
+ * (AudioEngine이 첫 콜백에서 이 스레드에 실시간 스케줄링 적용)
+ */
+class AlsaOutputDevice : public juce::AudioIODevice {
+public:
+    /**
+     * @param deviceName ALSA PCM 이름 ("hw:0,0", "plughw:0,0", "null", "hw:Loopback,0")
+     * @param frames 주기당 프레임 수 (32 이상)
+     * @param periods 링 버퍼 주기 수 (2 이상)
+     */
+    AlsaOutputDevice(const juce::String& deviceName, int frames, int periods);
+    ~AlsaOutputDevice() override;
+    
+    /**
+     * 디바이스가 보고한 실제 출력 지연 (snd_pcm_delay, 프레임)
+     * 마지막 주기 기준 값과 시작 이후 최소/최대
+     */
+    int getCurrentDelayFrames() const { return currentDelay.load(std::memory_order_relaxed); }
+    int getMinDelayFrames() const { return minDelay.load(std::memory_order_relaxed); }
+    int getMaxDelayFrames() const { return maxDelay.load(std::memory_order_relaxed); }
+    
+    /**
+     * 실제로 설정된 주기 수 (open() 이후)
+     */
+    int getNumPeriods() const { return numPeriods; }
+    
+    // juce::AudioIODevice
+    juce::StringArray getOutputChannelNames() override;
+    juce::StringArray getInputChannelNames() override { return {}; }
+    juce::Array<double> getAvailableSampleRates() override { return { 44100.0, 48000.0, 96000.0 }; }
+    juce::Array<int> getAvailableBufferSizes() override { return { 32, 64, 128, 256, 512 }; }
+    int getDefaultBufferSize() override { return 64; }
+    juce::String open(const juce::BigInteger& inputChannels, const juce::BigInteger& outputChannels,
+                      double sampleRate, int bufferSizeSamples) override;
+    void close() override;
+    bool isOpen() override { return pcm != nullptr; }
+    void start(juce::AudioIODeviceCallback* callback) override;
+    void stop() override;
+    bool isPlaying() override { return running.load(); }
+    juce::String getLastError() override { return lastError; }
+    int getCurrentBufferSizeSamples() override { return periodSize; }
+    double getCurrentSampleRate() override { return sampleRate; }
+    int getCurrentBitDepth() override { return bitDepth; }
+    juce::BigInteger getActiveOutputChannels() const override;
+    juce::BigInteger getActiveInputChannels() const override { return {}; }
+    int getOutputLatencyInSamples() override { return periodSize * numPeriods; }
+    int getInputLatencyInSamples() override { return 0; }
+    int getXRunCount() const noexcept override { return xrunCount.load(std::memory_order_relaxed); }  // ALSA 언더런 (EPIPE)
+    
+private:
+    /** 인터리브 샘플 포맷 (디바이스가 지원하는 첫 번째) */
+    enum class SampleFormat { Float32, Int32, Int16 };
+    
+    bool prefill();
+    bool writePeriod(uint64_t callbackNs);
+    bool recover(int err);
+    void updateDelay();
+    void run();
+    
+    juce::String pcmName;
+    int periodSize;
+    int numPeriods;
+    int numChannels = 2;
+    double sampleRate = 48000.0;
+    int bitDepth = 32;
+    SampleFormat format = SampleFormat::Float32;
+    juce::String lastError;
+    
+#if JUCE_LINUX
+    snd_pcm_t* pcm = nullptr;
+#else
+    void* pcm = nullptr;
+#endif
+    std::vector<std::vector<float>> channelData;
+    std::vector<float*> channelPointers;
+    
+    juce::AudioIODeviceCallback* callback = nullptr;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<int> xrunCount{0};
+    std::atomic<int> currentDelay{0};
+    std::atomic<int> minDelay{0};
+    std::atomic<int> maxDelay{0};
+};
+
+} // namespace FXBoard
@@ -0,0 +1,96 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+namespace FXBoard {
+
+/**
+ * 오디오 클록 추정기 (2차 DLL)
+ * 콜백 시각(CLOCK_MONOTONIC)으로 블록 시작 시각과 실제 샘플 주기를 추정해
+ * 이벤트 타임스탬프를 블록 내 샘플 오프셋으로 변환
+ *
+ * 참고: F. Adriaensen, "Using a DLL to filter time"
+ */
+class AudioClock {
+public:
+    /**
+     * @param sr 명목 샘플레이트 (Hz)
+     * @param bandwidthHz 루프 대역폭 (낮을수록 콜백 지터에 둔감)
+     */
+    void reset(double sr, double bandwidthHz = 1.0) {
+        sampleRate = sr;
+        bandwidth = bandwidthHz;
+        initialised = false;
+        blockSize = 0;
+    }
+    
+    /**
+     * 매 콜백 시작 시 호출
+     * @param callbackNs 콜백 시각 (나노초)
+     * @param numSamples 이번 블록 크기
+     */
+    void update(uint64_t callbackNs, int numSamples) {
+        double now = static_cast<double>(callbackNs);
+        
+        if (!initialised || numSamples != blockSize) {
+            initialise(now, numSamples);
+            return;
+        }
+        
+        double error = now - t1;
+        
+        // xrun 등으로 크게 어긋나면 다시 잠금
+        if (std::abs(error) > 4.0 * e2) {
+            initialise(now, numSamples);
+            return;
+        }
+        
+        t0 = t1;
+        t1 += b * error + e2;
+        e2 += c * error;
+    }
+    
+    bool isValid() const { return initialised; }
+    
+    /** 현재 블록 시작 시각 추정값 (나노초) */
+    double getBlockStartNs() const { return t0; }
+    
+    /** 샘플당 실제 주기 추정값 (나노초) */
+    double getNsPerSample() const { return e2 / blockSize; }
+    
+    /** 추정 샘플레이트 (Hz) */
+    double getEstimatedSampleRate() const { return 1.0e9 * blockSize / e2; }
+    
+    /**
+     * 시각 → 현재 블록 기준 샘플 오프셋
+     * @return 0 미만이면 이미 지난 시각, numSamples 이상이면 이후 블록
+     */
+    int64_t sampleOffsetFor(uint64_t timeNs) const {
+        return static_cast<int64_t>(std::floor((static_cast<double>(timeNs) - t0) * blockSize / e2));
+    }
+    
+private:
+    void initialise(double now, int numSamples) {
+        blockSize = numSamples;
+        e2 = 1.0e9 * numSamples / sampleRate;  // 블록 주기 (ns)
+        t0 = now;
+        t1 = now + e2;
+        
+        double omega = 2.0 * 3.141592653589793 * bandwidth * e2 * 1.0e-9;
+        b = std::sqrt(2.0) * omega;
+        c = omega * omega;
+        initialised = true;
+    }
+    
+    double sampleRate = 48000.0;
+    double bandwidth = 1.0;
+    bool initialised = false;
+    int blockSize = 0;
+    
+    double t0 = 0.0;  // 현재 블록 시작
+    double t1 = 0.0;  // 다음 블록 시작 예측
+    double e2 = 0.0;  // 블록 주기 추정
+    double b = 0.0, c = 0.0;
+};
+
+} // namespace FXBoard
@@ -1,46 +1,92 @@
 #include "AudioEngine.h"
+#include "RenderKernels.h"
+#include "../core/Clock.h"
+#include "../core/Realtime.h"
+#include "../core/RtLog.h"
+#include <algorithm>
+#include <cmath>
 
 namespace FXBoard {
 
 AudioEngine::AudioEngine() : samplePlayer(16) {
     mixer.getMasterLimiter().setThreshold(-1.0f);
+    keyRates.fill(1.0f);
+    samplePlayer.setStreamer(&sampleManager.getStreamer());
+    RenderKernels::getIsa();  // CPU 기능 감지를 오디오 스레드 밖에서 미리 수행
 }
 
 AudioEngine::~AudioEngine() {
     stop();
 }
 
-bool AudioEngine::initialize(int bufferSize) {
-    // 오디오 디바이스 초기화 - 가장 간단한 방법
-    juce::String error = deviceManager.initialiseWithDefaultDevices(0, 2);
+bool AudioEngine::initialize(double sampleRate, int bufferSize, const juce::String& deviceName, int numOutputChannels) {
+    juce::String error = deviceManager.initialiseWithDefaultDevices(0, numOutputChannels);
     
     if (error.isNotEmpty()) {
         juce::Logger::writeToLog("Audio device error: " + error);
         return false;
     }
     
-    // 버퍼 크기 설정
-    auto* device = deviceManager.getCurrentAudioDevice();
-    if (device != nullptr) {
+    // 설정의 디바이스/샘플레이트/버퍼 크기 적용
+    if (deviceManager.getCurrentAudioDevice() != nullptr) {
         juce::AudioDeviceManager::AudioDeviceSetup setup;
         deviceManager.getAudioDeviceSetup(setup);
         
+        if (deviceName.isNotEmpty()) {
+            setup.outputDeviceName = deviceName;
+        }
         setup.bufferSize = bufferSize;
-        setup.sampleRate = 48000.0;
+        setup.sampleRate = sampleRate;
         
         error = deviceManager.setAudioDeviceSetup(setup, true);
         if (error.isNotEmpty()) {
             juce::Logger::writeToLog("Audio setup warning: " + error);
-            // 경고만 표시하고 계속 진행
+            // 경고만 표시하고 디바이스가 고른 값으로 계속 진행
         }
     }
     
-    // FX 초기화
-    double sampleRate = 48000.0;
-    if (auto* device = deviceManager.getCurrentAudioDevice()) {
-        sampleRate = device->getCurrentSampleRate();
+    auto* device = deviceManager.getCurrentAudioDevice();
+    if (device == nullptr) {
+        juce::Logger::writeToLog("Audio device error: no output device");
+        return false;
+    }
+    
+    // FX 초기화 (디바이스가 실제로 고른 샘플레이트 기준)
+    prepareToPlay(device->getCurrentSampleRate());
+    
+    juce::Logger::writeToLog("Audio initialized: " + device->getName() + ", " +
+                             juce::String(device->getCurrentSampleRate()) + " Hz, " +
+                             juce::String(device->getCurrentBufferSizeSamples()) + " samples, " +
+                             RenderKernels::getIsaName(RenderKernels::getIsa()) + " render kernels");
+    
+    return true;
+}
+
+bool AudioEngine::initializeWithDevice(std::unique_ptr<juce::AudioIODevice> device, double sampleRate, int bufferSize) {
+    juce::BigInteger outputChannels;
+    outputChannels.setRange(0, 2, true);
+    
+    juce::String error = device->open({}, outputChannels, sampleRate, bufferSize);
+    if (error.isNotEmpty()) {
+        juce::Logger::writeToLog("Audio device error: " + error);
+        return false;
     }
     
+    prepareToPlay(device->getCurrentSampleRate());
+    
+    juce::Logger::writeToLog("Audio initialized: " + device->getName() + ", " +
+                             juce::String(device->getCurrentSampleRate()) + " Hz, " +
+                             juce::String(device->getCurrentBufferSizeSamples()) + " samples");
+    
+    ownDevice = std::move(device);
+    return true;
+}
+
+void AudioEngine::prepareToPlay(double sampleRate) {
+    // 샘플을 출력 레이트로 변환 (이후 로드하는 샘플도 로드 시 변환)
+    samplePlayer.setOutputSampleRate(sampleRate);
+    sampleManager.setTargetSampleRate(sampleRate);
+    
     filter.setup(sampleRate, BiquadFilter::LowPass);
     filter.setCutoff(1000.0f);
     filter.setResonance(0.707f);
@@ -52,20 +98,94 @@ bool AudioEngine::initialize(int bufferSize) {
     reverb.setup(sampleRate);
     reverb.setMix(0.0f);
     reverb.setDecay(0.5f);
-    
-    juce::Logger::writeToLog(juce::String("Audio initialized: ") + 
-                            juce::String(sampleRate) + " Hz, " + 
-                            juce::String(bufferSize) + " samples");
-    
-    return true;
 }
 
 void AudioEngine::start() {
-    deviceManager.addAudioCallback(this);
+    numDeferred = 0;
+    xrunCount = 0;
+    deviceXRunBase = 0;
+    for (auto& histogram : latencyHistograms) {
+        histogram.reset();
+    }
+    
+    if (ownDevice != nullptr) {
+        ownDevice->start(this);
+    } else {
+        deviceManager.addAudioCallback(this);
+    }
 }
 
 void AudioEngine::stop() {
-    deviceManager.removeAudioCallback(this);
+    if (ownDevice != nullptr) {
+        ownDevice->stop();
+    } else {
+        deviceManager.removeAudioCallback(this);
+    }
+    renderPool.stop();
+}
+
+void AudioEngine::setParallelRendering(int numThreads, int minVoices, int firstCpu) {
+    renderThreads = juce::jlimit(0, VoiceRenderPool::MAX_WORKERS, numThreads);
+    renderFirstCpu = firstCpu;
+    samplePlayer.setRenderPool(renderThreads > 0 ? &renderPool : nullptr, minVoices);
+}
+
+void AudioEngine::startRenderPool(int numChannels, int priority) {
+    if (renderThreads <= 0) return;
+    
+    // 버퍼 크기 변경 등으로 디바이스가 다시 시작해도 채널 수가 같으면 워커 유지
+    if (renderPool.isRunning() && renderPool.canRender(numChannels, 0, 0)) return;
+    
+    renderPool.start(renderThreads, numChannels, priority, renderFirstCpu);
+}
+
+bool AudioEngine::setBufferSize(int newBufferSize) {
+    auto* device = getCurrentDevice();
+    if (device == nullptr || !device->isPlaying()) return false;
+    if (newBufferSize == device->getCurrentBufferSizeSamples()) return true;
+    
+    // 출력을 한 블록 동안 0으로 줄인 뒤 재설정 (재시작 중 끊김이 클릭으로 들리지 않도록).
+    // FadeSilent는 아래에서 FadeInPending으로 바꿀 때까지 유지되므로 폴링이 놓치지 않음.
+    // 콜백이 멈춘 디바이스에서만 타임아웃에 걸리며, 그때는 들리는 출력도 없음
+    outputFade.store(FadeOutRequested, std::memory_order_release);
+    for (int i = 0; i < 500 && outputFade.load(std::memory_order_acquire) != FadeSilent; ++i) {
+        juce::Thread::sleep(1);
+    }
+    
+    // 재시작 전 디바이스 언더런 수를 누적 (디바이스 카운터는 다시 열 때 0부터)
+    deviceXRunBase += juce::jmax(0, device->getXRunCount());
+    
+    juce::String error;
+    if (ownDevice != nullptr) {
+        const double sampleRate = ownDevice->getCurrentSampleRate();
+        const auto outputs = ownDevice->getActiveOutputChannels();
+        ownDevice->stop();
+        ownDevice->close();
+        error = ownDevice->open({}, outputs, sampleRate, newBufferSize);
+        if (error.isEmpty()) {
+            ownDevice->start(this);
+        }
+    } else {
+        juce::AudioDeviceManager::AudioDeviceSetup setup;
+        deviceManager.getAudioDeviceSetup(setup);
+        setup.bufferSize = newBufferSize;
+        error = deviceManager.setAudioDeviceSetup(setup, true);
+    }
+    
+    // 재시작된 첫 블록에서 페이드 인 (그 전까지 오디오 스레드는 무음 유지)
+    outputFade.store(FadeInPending, std::memory_order_release);
+    
+    if (error.isNotEmpty()) {
+        juce::Logger::writeToLog("Buffer size change to " + juce::String(newBufferSize) + " failed: " + error);
+        return false;
+    }
+    return getCurrentDevice() != nullptr && getCurrentDevice()->getCurrentBufferSizeSamples() == newBufferSize;
+}
+
+int AudioEngine::getDeviceXRunCount() const {
+    auto* device = getCurrentDevice();
+    int current = device != nullptr ? juce::jmax(0, device->getXRunCount()) : 0;
+    return deviceXRunBase + current;
 }
 
 void AudioEngine::mapKeyToSample(uint32_t scancode, const juce::String& sampleId) {
@@ -74,6 +194,12 @@ void AudioEngine::mapKeyToSample(uint32_t scancode, const juce::String& sampleId
     }
 }
 
+void AudioEngine::setKeyTuning(uint32_t scancode, float semitones) {
+    if (scancode < MAX_KEYS) {
+        keyRates[scancode] = std::exp2(juce::jlimit(-48.0f, 48.0f, semitones) / 12.0f);
+    }
+}
+
 void AudioEngine::unmapKey(uint32_t scancode) {
     if (scancode < MAX_KEYS) {
         keyToSampleMap[scancode] = juce::String();
@@ -92,7 +218,60 @@ std::map<uint32_t, juce::String> AudioEngine::getKeyMappings() const {
 
 void AudioEngine::audioDeviceAboutToStart(juce::AudioIODevice* device) {
     juce::Logger::writeToLog("Audio device started: " + device->getName());
+    rtApplied = false;  // 디바이스 재시작 시 콜백 스레드가 바뀔 수 있음
+    startRenderPool(device->getActiveOutputChannels().countNumberOfSetBits(), rtPriority);
+    
+    // 디바이스가 다른 레이트로 다시 시작: 변환이 끝날 때까지는 레이트 비율로 보간 재생
+    const double deviceRate = device->getCurrentSampleRate();
+    if (deviceRate > 0.0 && std::abs(deviceRate - sampleManager.getTargetSampleRate()) >= 0.5) {
+        juce::Logger::writeToLog("Device sample rate changed to " + juce::String(deviceRate, 0) +
+                                 " Hz, resampling samples in background");
+        samplePlayer.setOutputSampleRate(deviceRate);
+        sampleManager.convertInBackground(deviceRate);
+    }
+    
+    resetTiming(device->getCurrentSampleRate(),
+                device->getCurrentBufferSizeSamples(),
+                device->getOutputLatencyInSamples());
+}
+
+void AudioEngine::prepareOffline(double sampleRate, int blockSize, int numChannels) {
+    prepareToPlay(sampleRate);
+    startRenderPool(numChannels, 0);
     xrunCount = 0;
+    rtApplied = true;  // 호출 스레드 스케줄링은 건드리지 않음
+    numDeferred = 0;
+    resetTiming(sampleRate, blockSize, 0);
+    for (auto& histogram : latencyHistograms) {
+        histogram.reset();
+    }
+}
+
+void AudioEngine::renderOffline(float* const* outputChannelData, int numOutputChannels,
+                                int numSamples, uint64_t blockTimeNs) {
+    processEvents(numSamples, blockTimeNs);
+    processAudio(outputChannelData, numOutputChannels, numSamples);
+}
+
+void AudioEngine::resetTiming(double sampleRate, int bufferSize, int outputLatency) {
+    // 오디오 클록/스케줄링 지연 재설정
+    currentSampleRate = sampleRate;
+    if (currentSampleRate <= 0.0) {
+        currentSampleRate = 48000.0;
+    }
+    audioClock.reset(currentSampleRate);
+    lastCallbackStartNs = 0;
+    
+    outputLatencySamples = outputLatency;
+    
+    double delayMs = schedulingDelayMs;
+    if (delayMs < 0.0) {
+        // 자동: 한 버퍼 주기 (직전 블록 동안 들어온 입력이 다음 블록 안에 배치됨)
+        delayMs = bufferSize * 1000.0 / currentSampleRate;
+    }
+    schedulingDelayNs = static_cast<uint64_t>(delayMs * 1.0e6);
+    juce::Logger::writeToLog("Trigger scheduling delay: " + juce::String(delayMs, 2) + " ms" +
+                             (schedulingDelayNs == 0 ? " (disabled)" : ""));
 }
 
 void AudioEngine::audioDeviceStopped() {
@@ -107,62 +286,195 @@ void AudioEngine::audioDeviceIOCallbackWithContext(
     int numSamples,
     const juce::AudioIODeviceCallbackContext& context) 
 {
-    juce::ignoreUnused(inputChannelData, numInputChannels, context);
+    juce::ignoreUnused(inputChannelData, numInputChannels);
+    
+    // 첫 콜백에서 한 번만: 콜백 스레드를 SCHED_FIFO로
+    if (!rtApplied) {
+        rtApplied = true;
+        RtLog::registerThread();
+        if (rtPriority > 0) {
+            Realtime::configureCurrentThread(rtPriority, rtCpu, "Audio");
+        }
+    }
     
     auto startTime = juce::Time::getHighResolutionTicks();
     
+    // 콜백 시각: 호스트가 제공하면 그 값, 아니면 지금 (둘 다 CLOCK_MONOTONIC 기준)
+    uint64_t callbackNs = (context.hostTimeNs != nullptr) ? *context.hostTimeNs : monotonicNowNs();
+    
+    // 콜백 간격이 한 주기를 넘게 벌어졌으면 마감을 놓친 것 (재시작 직후 첫 콜백은 제외)
+    if (lastCallbackStartNs != 0) {
+        const double periodNs = numSamples * 1.0e9 / currentSampleRate;
+        if (static_cast<double>(callbackNs - lastCallbackStartNs) > periodNs * XRUN_GAP_FACTOR) {
+            xrunCount.fetch_add(1, std::memory_order_relaxed);
+            RtLog::warning("Audio callback gap: {} us", (callbackNs - lastCallbackStartNs) / 1000);
+        }
+    }
+    
     // 이벤트 처리
-    processEvents();
+    processEvents(numSamples, callbackNs);
     
     // 오디오 처리
     processAudio(outputChannelData, numOutputChannels, numSamples);
+    applyOutputFade(outputChannelData, numOutputChannels, numSamples);
     
     // CPU 부하 계산
     auto endTime = juce::Time::getHighResolutionTicks();
     double elapsed = juce::Time::highResolutionTicksToSeconds(endTime - startTime);
-    double bufferDuration = numSamples / 48000.0;
+    double bufferDuration = numSamples / currentSampleRate;
     cpuLoad = (elapsed / bufferDuration) * 100.0;
 }
 
-void AudioEngine::processEvents() {
-    KeyEvent event;
-    int eventCount = 0;
-    while (eventQueue.pop(event)) {
-        eventCount++;
-        if (event.scancode >= MAX_KEYS) {
-            juce::Logger::writeToLog("Event scancode too large: " + juce::String(event.scancode));
+void AudioEngine::applyOutputFade(float* const* outputChannelData, int numOutputChannels, int numSamples) {
+    const int fade = outputFade.load(std::memory_order_acquire);
+    if (fade == FadeNone) return;
+    
+    for (int ch = 0; ch < numOutputChannels; ++ch) {
+        float* data = outputChannelData[ch];
+        if (fade == FadeSilent) {
+            std::fill(data, data + numSamples, 0.0f);
             continue;
         }
-        
-        auto& keyState = keyStates[event.scancode];
-        
-        if (event.type == KeyEvent::Down) {
-            keyState.onDown(event.timestampNs);
+        for (int i = 0; i < numSamples; ++i) {
+            const float ramp = static_cast<float>(i) / static_cast<float>(numSamples);
+            data[i] *= (fade == FadeOutRequested) ? 1.0f - ramp : ramp;
+        }
+    }
+    
+    // 메인 스레드가 그 사이 바꾼 상태는 덮어쓰지 않음. FadeSilent는 메인 스레드만 해제
+    int expected = fade;
+    if (fade == FadeOutRequested) {
+        outputFade.compare_exchange_strong(expected, FadeSilent, std::memory_order_acq_rel);
+    } else if (fade == FadeInPending) {
+        outputFade.compare_exchange_strong(expected, FadeNone, std::memory_order_acq_rel);
+    }
+}
+
+void AudioEngine::processEvents(int numSamples, uint64_t callbackNs) {
+    // 이전 콜백 시작 전에 발생한 key-down은 한 콜백 이상 대기한 것
+    uint64_t previousCallbackStartNs = lastCallbackStartNs;
+    lastCallbackStartNs = callbackNs;
+    
+    audioClock.update(callbackNs, numSamples);
+    
+    // 이전 블록에서 미뤄 둔 이벤트 먼저 (순서 유지)
+    int numStillDeferred = 0;
+    for (int i = 0; i < numDeferred; ++i) {
+        if (!scheduleEvent(deferredEvents[i], numSamples)) {
+            deferredEvents[numStillDeferred++] = deferredEvents[i];
+        }
+    }
+    numDeferred = numStillDeferred;
+    
+    // 큐에서 묶음 단위로 꺼냄 (슬롯마다 atomic 왕복 없이 연속 처리)
+    std::array<KeyEvent, 64> batch;
+    int eventCount = 0;
+    size_t numPopped;
+    while ((numPopped = eventQueue.popBulk(batch.data(), batch.size())) > 0) {
+        for (size_t i = 0; i < numPopped; ++i) {
+            const auto& event = batch[i];
+            eventCount++;
+            if (event.scancode >= MAX_KEYS) {
+                RtLog::warning("Event scancode too large: {}", event.scancode);
+                continue;
+            }
             
-            // 샘플 트리거
-            const auto& sampleId = keyToSampleMap[event.scancode];
-            juce::Logger::writeToLog("Processing key down - scancode: " + juce::String(event.scancode) + 
-                                     ", sampleId: " + sampleId);
-            if (sampleId.isNotEmpty()) {
-                const Sample* sample = sampleManager.getSample(sampleId);
-                if (sample != nullptr) {
-                    juce::Logger::writeToLog("Triggering sample: " + sampleId + 
-                                           ", samples: " + juce::String(sample->buffer.getNumSamples()));
-                    samplePlayer.trigger(sample, 1.0f);
-                } else {
-                    juce::Logger::writeToLog("Sample not found: " + sampleId);
+            if (event.type == KeyEvent::Down) {
+                keyDownsProcessed.fetch_add(1, std::memory_order_relaxed);
+                if (event.timestampNs < previousCallbackStartNs) {
+                    lateKeyDowns.fetch_add(1, std::memory_order_relaxed);
                 }
-            } else {
-                juce::Logger::writeToLog("No sample mapped for scancode: " + juce::String(event.scancode));
             }
             
-        } else if (event.type == KeyEvent::Up) {
-            keyState.onUp(event.timestampNs);
+            // 앞선 이벤트가 대기 중이면 순서를 지키기 위해 뒤에 붙임
+            PendingEvent pending { event, callbackNs };
+            if (numDeferred > 0 || !scheduleEvent(pending, numSamples)) {
+                if (numDeferred < MAX_DEFERRED_EVENTS) {
+                    deferredEvents[numDeferred++] = pending;
+                } else {
+                    handleEvent(pending, numSamples - 1);  // 대기열 가득 참 - 이번 블록 끝에서 시작
+                }
+            }
         }
     }
     if (eventCount > 0) {
-        juce::Logger::writeToLog("Processed " + juce::String(eventCount) + " events");
+        RtLog::debug("Processed {} events ({} deferred)", eventCount, numDeferred);
+    }
+}
+
+bool AudioEngine::scheduleEvent(const PendingEvent& pending, int numSamples) {
+    int offset = 0;
+    
+    if (schedulingDelayNs > 0 && audioClock.isValid()) {
+        int64_t pos = audioClock.sampleOffsetFor(pending.event.timestampNs + schedulingDelayNs);
+        if (pos >= numSamples) {
+            // 이후 블록 대상. 단, 1초 이상 미래면 타임스탬프 시간축이 다른 것으로 보고 즉시 처리
+            if (pos < static_cast<int64_t>(currentSampleRate)) {
+                return false;
+            }
+            pos = 0;
+        }
+        offset = static_cast<int>(juce::jmax<int64_t>(pos, 0));  // 늦은 이벤트는 블록 시작에서
     }
+    
+    handleEvent(pending, offset);
+    return true;
+}
+
+void AudioEngine::handleEvent(const PendingEvent& pending, int sampleOffset) {
+    const auto& event = pending.event;
+    auto& keyState = keyStates[event.scancode];
+    
+    if (event.type == KeyEvent::Down) {
+        keyState.onDown(event.timestampNs);
+        
+        // 샘플 트리거
+        const auto& sampleId = keyToSampleMap[event.scancode];
+        if (sampleId.isNotEmpty()) {
+            const Sample* sample = sampleManager.getSample(sampleId);
+            if (sample != nullptr) {
+                RtLog::debug("Trigger scancode {} at offset {} ({} samples)",
+                             event.scancode, sampleOffset, sample->getNumFrames());
+                float rate = keyRates[event.scancode];
+                if (sample->pitchRandom > 0.0f) {
+                    // xorshift32 → [-1, 1)
+                    pitchRandomState ^= pitchRandomState << 13;
+                    pitchRandomState ^= pitchRandomState >> 17;
+                    pitchRandomState ^= pitchRandomState << 5;
+                    const float random = static_cast<float>(pitchRandomState) * (2.0f / 4294967296.0f) - 1.0f;
+                    rate *= std::exp2(sample->pitchRandom * random / 12.0f);
+                }
+                samplePlayer.trigger(sample, event.velocity / 127.0f, sampleOffset, rate);
+                recordLatency(pending, sampleOffset);
+            } else {
+                RtLog::warning("Sample not loaded for scancode {}", event.scancode);
+            }
+        } else {
+            RtLog::debug("No sample mapped for scancode {}", event.scancode);
+        }
+        
+    } else if (event.type == KeyEvent::Up) {
+        keyState.onUp(event.timestampNs);
+    }
+}
+
+void AudioEngine::recordLatency(const PendingEvent& pending, int sampleOffset) {
+    double nsPerSample = audioClock.isValid() ? audioClock.getNsPerSample() : 1.0e9 / currentSampleRate;
+    double blockStartNs = audioClock.isValid() ? audioClock.getBlockStartNs()
+                                               : static_cast<double>(lastCallbackStartNs);
+    
+    auto toUs = [](double ns) { return ns > 0.0 ? static_cast<uint64_t>(ns / 1000.0) : uint64_t{0}; };
+    
+    double inputNs = static_cast<double>(pending.event.timestampNs);
+    double dequeueNs = static_cast<double>(pending.dequeueNs);
+    double offsetNs = sampleOffset * nsPerSample;
+    double outputNs = outputLatencySamples * nsPerSample;
+    
+    latencyHistograms[LatencyInputToDequeue].record(toUs(dequeueNs - inputNs));
+    latencyHistograms[LatencyDequeueToBlock].record(toUs(blockStartNs - dequeueNs));
+    latencyHistograms[LatencyBlockOffset].record(toUs(offsetNs));
+    latencyHistograms[LatencyDeviceOutput].record(toUs(outputNs));
+    latencyHistograms[LatencyTotal].record(toUs(blockStartNs + offsetNs + outputNs - inputNs));
 }
 
 void AudioEngine::processAudio(float* const* outputChannelData, 
@@ -172,6 +484,10 @@ void AudioEngine::processAudio(float* const* outputChannelData,
     juce::AudioBuffer<float> buffer(outputChannelData, numOutputChannels, numSamples);
     buffer.clear();
     
+    // 백그라운드에서 디코딩/변환을 마친 샘플 교체 (블록 경계에서만)
+    sampleManager.applyLoadedSamples();
+    sampleManager.applyConvertedSamples(samplePlayer);
+    
     // 샘플 렌더링
     samplePlayer.renderNextBlock(buffer, 0, numSamples);
     
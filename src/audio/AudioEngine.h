@@ -1,11 +1,15 @@
 #pragma once
 #include "../core/EventQueue.h"
+#include "../core/LatencyHistogram.h"
 #include "../input/KeyState.h"
 #include "SampleManager.h"
 #include "Mixer.h"
 #include "FX.h"
+#include "AudioClock.h"
+#include "VoiceRenderPool.h"
 #include <juce_audio_devices/juce_audio_devices.h>
 #include <array>
+#include <memory>
 
 namespace FXBoard {
 
@@ -15,15 +19,106 @@ namespace FXBoard {
  */
 class AudioEngine : public juce::AudioIODeviceCallback {
 public:
-    static constexpr int MAX_KEYS = 256;
+    static constexpr int MAX_KEYS = KeyEvent::MIDI_NOTE_BASE + 128;  // 키보드 스캔코드 + MIDI 노트
+    
+    /**
+     * 트리거된 보이스마다 기록하는 지연 구간
+     */
+    enum LatencyStage {
+        LatencyInputToDequeue,   // 입력 타임스탬프 → 오디오 스레드가 꺼낸 시각
+        LatencyDequeueToBlock,   // 꺼낸 시각 → 재생 블록 시작
+        LatencyBlockOffset,      // 블록 내 시작 오프셋
+        LatencyDeviceOutput,     // 디바이스 보고 출력 지연
+        LatencyTotal,            // 입력 → 추정 출력 시각 (위 네 구간의 합)
+        NumLatencyStages
+    };
     
     AudioEngine();
     ~AudioEngine() override;
     
     /**
-     * 오디오 디바이스 초기화
+     * 오디오 디바이스 초기화 (JUCE 디바이스 매니저)
+     * 디바이스가 요청 값을 지원하지 않으면 디바이스가 고른 값으로 진행
+     * @param deviceName 출력 디바이스 이름 (빈 문자열 = 기본 디바이스)
+     */
+    bool initialize(double sampleRate = 48000.0, int bufferSize = 128,
+                    const juce::String& deviceName = {}, int numOutputChannels = 2);
+    
+    /**
+     * JUCE 디바이스 매니저 대신 직접 만든 디바이스로 초기화 (예: AlsaOutputDevice)
+     * initialize() 대신 호출. 이후 start()/stop()이 이 디바이스를 구동
+     */
+    bool initializeWithDevice(std::unique_ptr<juce::AudioIODevice> device, double sampleRate, int bufferSize);
+    
+    /**
+     * 디바이스 없이 처리 준비 (샘플 레이트 변환, FX 초기화)
+     * initialize()가 호출하며, 자체 디바이스/오프라인 렌더링에서 직접 사용
+     */
+    void prepareToPlay(double sampleRate);
+    
+    /**
+     * 디바이스 없는 오프라인 렌더링 준비 (audioDeviceAboutToStart 대응)
+     * 이후 renderOffline()을 호출하는 스레드가 오디오 스레드 역할
+     */
+    void prepareOffline(double sampleRate, int blockSize, int numChannels = 2);
+    
+    /**
+     * 오프라인으로 한 블록 처리 (큐의 이벤트 처리 + 렌더링)
+     * @param blockTimeNs 블록 시작의 가상 시각 (이벤트 타임스탬프와 같은 시간축)
+     */
+    void renderOffline(float* const* outputChannelData, int numOutputChannels,
+                       int numSamples, uint64_t blockTimeNs);
+    
+    /**
+     * 오디오 콜백 스레드 실시간 스케줄링 설정
+     * 디바이스가 시작된 뒤 첫 콜백에서 해당 스레드에 적용
+     * @param priority SCHED_FIFO 우선순위 (0 = 일반 스케줄링)
+     * @param cpu 고정할 코어 (-1 = 고정 안 함)
+     */
+    void setRealtime(int priority, int cpu) { rtPriority = priority; rtCpu = cpu; }
+    
+    /**
+     * 트리거 스케줄링 지연 설정 (디바이스 시작 전에 호출)
+     * 키 입력 타임스탬프 + 지연 시각에 샘플 단위로 정확히 재생 시작
+     * 작은 고정 지연과 맞바꿔 버퍼 크기만큼의 지터를 제거
+     * @param ms 지연 (밀리초). 음수 = 자동 (한 버퍼 주기), 0 = 비활성 (블록 시작에서 재생)
+     */
+    void setSchedulingDelayMs(double ms) { schedulingDelayMs = ms; }
+    
+    /**
+     * 최대 동시 재생 보이스 수 (디바이스 시작 전에 호출)
+     */
+    void setMaxVoices(int maxVoices) { samplePlayer.setNumVoices(maxVoices); }
+    
+    /**
+     * 샘플별 기본 보이스 상한 (디바이스 시작 전에 호출, 0 = 상한 없음)
+     * 같은 키를 연타해도 다른 샘플이 쓸 보이스가 남도록 함. 샘플별 값은 SampleManager::setSampleMaxVoices
+     */
+    void setMaxVoicesPerSample(int maxVoices) { samplePlayer.setMaxVoicesPerSample(maxVoices); }
+    
+    /**
+     * 재생 속도가 1이 아닌 보이스(키 튜닝, 무작위 피치)의 보간 방식 (디바이스 시작 전에 호출)
      */
-    bool initialize(int bufferSize = 128);
+    void setInterpolation(RenderKernels::Interpolation mode) { samplePlayer.setInterpolation(mode); }
+    
+    /**
+     * 샘플 플레이어 (보이스 통계용)
+     */
+    const SamplePlayer& getSamplePlayer() const { return samplePlayer; }
+    
+    /**
+     * 병렬 보이스 렌더링 설정 (디바이스 시작 전에 호출)
+     * 워커는 디바이스가 시작될 때 오디오 스레드와 같은 우선순위로 생성
+     * @param numThreads 워커 스레드 수 (0 = 콜백 스레드에서 직렬 렌더링)
+     * @param minVoices 활성 보이스가 이보다 적은 블록은 직렬 렌더링
+     * @param firstCpu 첫 워커를 고정할 코어, 이후 워커는 다음 코어 (-1 = 고정 안 함)
+     */
+    void setParallelRendering(int numThreads, int minVoices, int firstCpu = -1);
+    
+    /**
+     * 병렬 렌더링 워커 풀 (통계용)
+     */
+    const VoiceRenderPool& getRenderPool() const { return renderPool; }
     
     /**
      * 오디오 시작/중지
@@ -53,11 +148,23 @@ public:
      */
     juce::AudioDeviceManager& getDeviceManager() { return deviceManager; }
     
+    /**
+     * 현재 출력 디바이스 (직접 만든 디바이스 또는 디바이스 매니저의 디바이스, 없으면 nullptr)
+     */
+    juce::AudioIODevice* getCurrentDevice() const {
+        return ownDevice != nullptr ? ownDevice.get() : deviceManager.getCurrentAudioDevice();
+    }
+    
     /**
      * 키에 샘플 매핑
      */
     void mapKeyToSample(uint32_t scancode, const juce::String& sampleId);
     
+    /**
+     * 키별 튜닝 (반음, 디바이스 시작 전에 호출) - 이 키의 트리거는 2^(semitones/12) 속도로 재생
+     */
+    void setKeyTuning(uint32_t scancode, float semitones);
+    
     /**
      * 키 매핑 제거
      */
@@ -82,17 +189,41 @@ public:
     BitCrusher& getBitCrusher() { return bitCrusher; }
     SimpleReverb& getReverb() { return reverb; }
     
+    /**
+     * 재생 중 버퍼 크기 변경 (메인 스레드)
+     * 출력을 한 블록 페이드 아웃 → 디바이스 재설정 → 페이드 인, 보이스와 통계는 유지
+     * @return 디바이스가 요청한 크기로 다시 시작했으면 true
+     */
+    bool setBufferSize(int newBufferSize);
+    
     /**
      * 통계 정보
+     * xrun = 콜백 간격이 주기의 XRUN_GAP_FACTOR배를 넘은 횟수 (오디오 스레드 측 검출)
+     * deviceXRun = 디바이스가 보고한 언더런 (지원하는 디바이스만, 버퍼 변경으로 재시작해도 누적)
+     * 둘은 같은 사건을 함께 셀 수 있으므로 합하지 말고 큰 쪽을 사용
      */
     int getXRunCount() const { return xrunCount; }
+    int getDeviceXRunCount() const;
     double getCpuLoad() const { return cpuLoad; }
     
+    /**
+     * 키 입력 전달 통계
+     * late = 이전 콜백 시작 전에 발생했는데 이번 콜백에서야 처리된 key-down
+     *        (0이면 모든 key-down이 한 콜백 이내에 오디오 스레드에 도달)
+     */
+    uint64_t getKeyDownsProcessed() const { return keyDownsProcessed.load(std::memory_order_relaxed); }
+    uint64_t getLateKeyDowns() const { return lateKeyDowns.load(std::memory_order_relaxed); }
+    
+    /**
+     * 키 입력-출력 지연 히스토그램 (p50/p99/p99.9/max는 LatencyHistogram에서)
+     */
+    const LatencyHistogram& getLatencyHistogram(LatencyStage stage) const { return latencyHistograms[stage]; }
+    
     /**
      * 레이턴시 계산
      */
     double getLatencyMs() const {
-        auto* device = deviceManager.getCurrentAudioDevice();
+        auto* device = getCurrentDevice();
         if (device == nullptr) return 0.0;
         
         int bufferSize = device->getCurrentBufferSizeSamples();
@@ -116,6 +247,7 @@ public:
     
 private:
     juce::AudioDeviceManager deviceManager;
+    std::unique_ptr<juce::AudioIODevice> ownDevice;  // initializeWithDevice() 사용 시
     EventQueue eventQueue;
     SampleManager sampleManager;
     SamplePlayer samplePlayer;
@@ -133,12 +265,56 @@ private:
     // 키 상태
     std::array<KeyState, MAX_KEYS> keyStates;
     std::array<juce::String, MAX_KEYS> keyToSampleMap;
+    std::array<float, MAX_KEYS> keyRates;  // 키 튜닝 재생 속도
+    uint32_t pitchRandomState = 0x9e3779b9u;  // 무작위 피치용 xorshift (오디오 스레드 전용)
     
     // 통계
+    static constexpr double XRUN_GAP_FACTOR = 2.0;
     std::atomic<int> xrunCount{0};
+    int deviceXRunBase = 0;  // 재시작 전까지 디바이스가 보고한 언더런
     std::atomic<double> cpuLoad{0.0};
+    std::atomic<uint64_t> keyDownsProcessed{0};
+    std::atomic<uint64_t> lateKeyDowns{0};
+    uint64_t lastCallbackStartNs = 0;  // 오디오 스레드 전용
+    
+    // 샘플 단위 트리거 스케줄링
+    static constexpr int MAX_DEFERRED_EVENTS = 256;
+    AudioClock audioClock;
+    double currentSampleRate = 48000.0;
+    double schedulingDelayMs = -1.0;
+    uint64_t schedulingDelayNs = 0;
+    struct PendingEvent {
+        KeyEvent event;
+        uint64_t dequeueNs;  // 오디오 스레드가 큐에서 꺼낸 시각
+    };
+    std::array<PendingEvent, MAX_DEFERRED_EVENTS> deferredEvents;  // 이후 블록 대상 이벤트
+    int numDeferred = 0;
+    
+    // 지연 측정
+    std::array<LatencyHistogram, NumLatencyStages> latencyHistograms;
+    int outputLatencySamples = 0;
+    
+    // 버퍼 크기 변경 시 출력 페이드 (메인 스레드 요청 → 오디오 스레드 진행, FadeSilent는 메인 스레드가 해제)
+    enum OutputFade { FadeNone, FadeOutRequested, FadeSilent, FadeInPending };
+    std::atomic<int> outputFade{FadeNone};
+    
+    // 병렬 보이스 렌더링
+    VoiceRenderPool renderPool;
+    int renderThreads = 0;
+    int renderFirstCpu = -1;
+    
+    // 실시간 스케줄링
+    int rtPriority = 0;
+    int rtCpu = -1;
+    bool rtApplied = false;  // 현재 콜백 스레드에 적용했는지
     
-    void processEvents();
+    void resetTiming(double sampleRate, int bufferSize, int outputLatency);
+    void startRenderPool(int numChannels, int priority);
+    void applyOutputFade(float* const* outputChannelData, int numOutputChannels, int numSamples);
+    void processEvents(int numSamples, uint64_t callbackNs);
+    bool scheduleEvent(const PendingEvent& pending, int numSamples);
+    void handleEvent(const PendingEvent& pending, int sampleOffset);
+    void recordLatency(const PendingEvent& pending, int sampleOffset);
     void processAudio(float* const* outputChannelData, int numOutputChannels, int numSamples);
 };
 
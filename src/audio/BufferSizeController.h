@@ -0,0 +1,123 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace FXBoard {
+
+/**
+ * 적응형 버퍼 크기 정책 (메인 스레드에서 주기적으로 호출, 디바이스는 건드리지 않음)
+ *
+ * - xrun 없는 구간이 cleanSeconds 이어지면 버퍼를 절반으로
+ * - xrunWindowSeconds 안에 xrun이 xrunLimit번 나면 두 배로
+ * - 어떤 크기에서 물러날 때마다 그 크기로 다시 내려가기 위한 대기 시간을 두 배로 (진동 방지)
+ */
+class BufferSizeController {
+public:
+    struct Config {
+        int minSize = 32;
+        int maxSize = 512;
+        double cleanSeconds = 30.0;
+        int xrunLimit = 2;
+        double xrunWindowSeconds = 10.0;
+    };
+    
+    enum class Reason { None, Clean, XRuns };
+    
+    struct Decision {
+        int newSize = 0;        // 0 = 유지
+        Reason reason = Reason::None;
+        int recentXRuns = 0;    // XRuns: 창 안의 xrun 수
+        double cleanFor = 0.0;  // Clean: xrun 없이 지난 시간 (초)
+    };
+    
+    /**
+     * @param xrunTotal 현재까지의 누적 xrun 수 (이후 증가분만 셈)
+     */
+    void reset(const Config& newConfig, int currentSize, double nowSeconds, int xrunTotal) {
+        config = newConfig;
+        if (config.xrunLimit < 1) config.xrunLimit = 1;
+        if (config.xrunLimit > MAX_TRACKED_XRUNS) config.xrunLimit = MAX_TRACKED_XRUNS;
+        size = currentSize;
+        cleanSince = nowSeconds;
+        lastXRunTotal = xrunTotal;
+        numRecent = 0;
+        backoff.fill(1.0);
+    }
+    
+    /**
+     * 새 xrun을 반영하고 크기 변경이 필요한지 판단
+     */
+    Decision update(double nowSeconds, int xrunTotal) {
+        Decision decision;
+        
+        for (; lastXRunTotal < xrunTotal; ++lastXRunTotal) {
+            recent[numRecent % MAX_TRACKED_XRUNS] = nowSeconds;
+            ++numRecent;
+            cleanSince = nowSeconds;
+        }
+        
+        int inWindow = 0;
+        for (size_t i = 0; i < numRecent && i < MAX_TRACKED_XRUNS; ++i) {
+            if (recent[i] >= nowSeconds - config.xrunWindowSeconds) ++inWindow;
+        }
+        
+        if (inWindow >= config.xrunLimit && size < config.maxSize) {
+            backoff[sizeIndex(size)] *= 2.0;  // 이 크기는 불안정 - 다음엔 더 오래 기다림
+            decision.newSize = size * 2 > config.maxSize ? config.maxSize : size * 2;
+            decision.reason = Reason::XRuns;
+            decision.recentXRuns = inWindow;
+            return decision;
+        }
+        
+        const int smaller = size / 2;
+        if (smaller >= config.minSize) {
+            const double cleanFor = nowSeconds - cleanSince;
+            if (cleanFor >= config.cleanSeconds * backoff[sizeIndex(smaller)]) {
+                decision.newSize = smaller;
+                decision.reason = Reason::Clean;
+                decision.cleanFor = cleanFor;
+            }
+        }
+        return decision;
+    }
+    
+    /**
+     * 크기 변경 결과 반영 (디바이스 재시작 중 생긴 xrun은 세지 않음)
+     * @param actualSize 디바이스가 실제로 다시 시작한 크기 (요청과 다르면 요청 크기도 불안정으로 처리)
+     */
+    void applied(int requestedSize, int actualSize, double nowSeconds, int xrunTotal) {
+        if (actualSize != requestedSize) {
+            backoff[sizeIndex(requestedSize)] *= 2.0;
+        }
+        size = actualSize;
+        cleanSince = nowSeconds;
+        lastXRunTotal = xrunTotal;
+        numRecent = 0;
+    }
+    
+    int getSize() const { return size; }
+    
+private:
+    static constexpr int MAX_TRACKED_XRUNS = 16;
+    static constexpr size_t NUM_SIZES = 16;
+    
+    /** 2의 거듭제곱 크기 → 인덱스 (그 외 크기는 가까운 아래쪽) */
+    static size_t sizeIndex(int bufferSize) {
+        size_t index = 0;
+        while (bufferSize > 1 && index < NUM_SIZES - 1) {
+            bufferSize >>= 1;
+            ++index;
+        }
+        return index;
+    }
+    
+    Config config;
+    int size = 0;
+    double cleanSince = 0.0;
+    int lastXRunTotal = 0;
+    std::array<double, MAX_TRACKED_XRUNS> recent {};
+    size_t numRecent = 0;
+    std::array<double, NUM_SIZES> backoff {};
+};
+
+} // namespace FXBoard
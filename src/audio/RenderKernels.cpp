@@ -0,0 +1,322 @@
+#include "RenderKernels.h"
+#include "RenderKernelsImpl.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FXBOARD_HAS_SSE2 1
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FXBOARD_HAS_NEON 1
+#endif
+
+namespace FXBoard {
+namespace RenderKernels {
+
+namespace Impl {
+
+float sincTable[(SINC_PHASES + 1) * SINC_TAPS];
+
+namespace {
+
+// 카이저 창 (β = 6) sinc, 차단 주파수는 나이퀴스트의 90%, 위상마다 DC 이득 1
+bool buildSincTable() {
+    constexpr double beta = 6.0;
+    constexpr double cutoff = 0.9;
+    constexpr int left = SINC_TAPS / 2 - 1;
+    auto besselI0 = [](double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 30; ++k) {
+            term *= x * 0.5 / k;
+            sum += term * term;
+        }
+        return sum;
+    };
+    const double pi = 3.14159265358979323846;
+    const double halfWidth = SINC_TAPS / 2.0;
+
+    for (int p = 0; p <= SINC_PHASES; ++p) {
+        const double phase = static_cast<double>(p) / SINC_PHASES;
+        double taps[SINC_TAPS];
+        double sum = 0.0;
+        for (int t = 0; t < SINC_TAPS; ++t) {
+            const double x = phase - (t - left);  // 출력 위치 - 탭 위치
+            const double arg = pi * cutoff * x;
+            const double sinc = std::abs(arg) < 1.0e-9 ? 1.0 : std::sin(arg) / arg;
+            const double w = x / halfWidth;
+            const double window = std::abs(w) >= 1.0 ? 0.0 : besselI0(beta * std::sqrt(1.0 - w * w)) / besselI0(beta);
+            taps[t] = sinc * window;
+            sum += taps[t];
+        }
+        for (int t = 0; t < SINC_TAPS; ++t) {
+            sincTable[p * SINC_TAPS + t] = static_cast<float>(taps[t] / sum);
+        }
+    }
+    return true;
+}
+
+[[maybe_unused]] const bool sincTableReady = buildSincTable();
+
+} // namespace
+
+} // namespace Impl
+
+using namespace Impl;
+
+namespace {
+
+#if FXBOARD_HAS_SSE2
+struct Sse2Vec {
+    static constexpr int width = 4;
+    using Reg = __m128;
+    static Reg zero() { return _mm_setzero_ps(); }
+    static Reg set1(float v) { return _mm_set1_ps(v); }
+    static Reg ramp(float base, float step) {
+        return _mm_add_ps(_mm_set1_ps(base), _mm_mul_ps(_mm_set1_ps(step), _mm_setr_ps(0, 1, 2, 3)));
+    }
+    static Reg load(const float* p) { return _mm_loadu_ps(p); }
+    static Reg load(const int16_t* p) {
+        // 16비트 4개를 32비트 위쪽 절반에 놓고 산술 시프트로 부호 확장
+        const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+        return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+    }
+    static void store(float* p, Reg v) { _mm_storeu_ps(p, v); }
+    static Reg add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+    static Reg abs(Reg a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static Reg max(Reg a, Reg b) { return _mm_max_ps(a, b); }
+    static float hmax(Reg a) {
+        Reg m = _mm_max_ps(a, _mm_movehl_ps(a, a));
+        m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+    static Reg gather(const float* base, const int* idx, int offset) {
+        return _mm_setr_ps(base[idx[0] + offset], base[idx[1] + offset], base[idx[2] + offset], base[idx[3] + offset]);
+    }
+    static Reg gather(const int16_t* base, const int* idx, int offset) {
+        return _mm_cvtepi32_ps(_mm_setr_epi32(base[idx[0] + offset], base[idx[1] + offset],
+                                              base[idx[2] + offset], base[idx[3] + offset]));
+    }
+};
+#endif
+
+#if FXBOARD_HAS_NEON
+struct NeonVec {
+    static constexpr int width = 4;
+    using Reg = float32x4_t;
+    static Reg zero() { return vdupq_n_f32(0.0f); }
+    static Reg set1(float v) { return vdupq_n_f32(v); }
+    static Reg ramp(float base, float step) {
+        static const float offsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+        return vmlaq_n_f32(vdupq_n_f32(base), vld1q_f32(offsets), step);
+    }
+    static Reg load(const float* p) { return vld1q_f32(p); }
+    static Reg load(const int16_t* p) { return vcvtq_f32_s32(vmovl_s16(vld1_s16(p))); }
+    static void store(float* p, Reg v) { vst1q_f32(p, v); }
+    static Reg add(Reg a, Reg b) { return vaddq_f32(a, b); }
+    static Reg sub(Reg a, Reg b) { return vsubq_f32(a, b); }
+    static Reg mul(Reg a, Reg b) { return vmulq_f32(a, b); }
+    static Reg abs(Reg a) { return vabsq_f32(a); }
+    static Reg max(Reg a, Reg b) { return vmaxq_f32(a, b); }
+    static float hmax(Reg a) { return vmaxvq_f32(a); }
+    static Reg gather(const float* base, const int* idx, int offset) {
+        const float lanes[4] = { base[idx[0] + offset], base[idx[1] + offset], base[idx[2] + offset], base[idx[3] + offset] };
+        return vld1q_f32(lanes);
+    }
+    static Reg gather(const int16_t* base, const int* idx, int offset) {
+        const int32_t lanes[4] = { base[idx[0] + offset], base[idx[1] + offset], base[idx[2] + offset], base[idx[3] + offset] };
+        return vcvtq_f32_s32(vld1q_s32(lanes));
+    }
+};
+#endif
+
+const KernelTable* getTable(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2:
+            return getAvx2Kernels();
+        case Isa::SSE2: {
+#if FXBOARD_HAS_SSE2
+            static const KernelTable table = makeKernelTable<Sse2Vec>();
+            return &table;
+#else
+            return nullptr;
+#endif
+        }
+        case Isa::NEON: {
+#if FXBOARD_HAS_NEON
+            static const KernelTable table = makeKernelTable<NeonVec>();
+            return &table;
+#else
+            return nullptr;
+#endif
+        }
+        case Isa::Scalar: {
+            static const KernelTable table = makeKernelTable<ScalarVec>();
+            return &table;
+        }
+    }
+    return nullptr;
+}
+
+bool cpuHasAvx2() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+Isa detectIsa() {
+    if (isSupported(Isa::AVX2)) return Isa::AVX2;
+    if (isSupported(Isa::NEON)) return Isa::NEON;
+    if (isSupported(Isa::SSE2)) return Isa::SSE2;
+    return Isa::Scalar;
+}
+
+// 처음 사용할 때 한 번 감지 (오디오 시작 전에 getIsa()로 미리 초기화해 두는 것을 권장)
+std::atomic<const KernelTable*> activeTable{nullptr};
+std::atomic<Isa> activeIsa{Isa::Scalar};
+
+const KernelTable& kernels() {
+    const KernelTable* table = activeTable.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        Isa isa = detectIsa();
+        activeIsa.store(isa, std::memory_order_relaxed);
+        table = getTable(isa);
+        activeTable.store(table, std::memory_order_release);
+    }
+    return *table;
+}
+
+} // namespace
+
+Isa getIsa() {
+    kernels();
+    return activeIsa.load(std::memory_order_relaxed);
+}
+
+const char* getIsaName(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::SSE2:   return "SSE2";
+        case Isa::AVX2:   return "AVX2";
+        case Isa::NEON:   return "NEON";
+    }
+    return "scalar";
+}
+
+bool isSupported(Isa isa) {
+    switch (isa) {
+        case Isa::AVX2:   return getAvx2Kernels() != nullptr && cpuHasAvx2();
+        case Isa::Scalar: return true;
+        case Isa::SSE2:
+        case Isa::NEON:   return getTable(isa) != nullptr;
+    }
+    return false;
+}
+
+bool setIsa(Isa isa) {
+    if (!isSupported(isa)) return false;
+    activeIsa.store(isa, std::memory_order_relaxed);
+    activeTable.store(getTable(isa), std::memory_order_release);
+    return true;
+}
+
+namespace {
+
+constexpr float INT16_SCALE = 1.0f / 32768.0f;
+
+template <typename S>
+float mixUnitStepWith(const KernelSet<S>& table, float* const* dst, int dstChannels, const S* const* src,
+                      int srcChannels, int numSamples, float gain, float gainStep) {
+    if (dstChannels == 2 && srcChannels == 1) return table.monoToStereo(dst, src, numSamples, gain, gainStep);
+    if (dstChannels == 2 && srcChannels >= 2) return table.stereo(dst, src, numSamples, gain, gainStep);
+
+    // 그 외 배치: 출력 채널마다 모노 커널
+    float peak = 0.0f;
+    for (int c = 0; c < dstChannels; ++c) {
+        const S* channelSrc = src[std::min(c, srcChannels - 1)];
+        peak = std::max(peak, table.mono(dst + c, &channelSrc, numSamples, gain, gainStep));
+    }
+    return peak;
+}
+
+template <typename S>
+float mixResampledWith(const ResampleFn<S> (&table)[NumLayouts], float* const* dst, int dstChannels,
+                       const S* const* src, int srcChannels, int srcLength,
+                       double position, double step, int numSamples, float gain, float gainStep) {
+    if (dstChannels == 2 && srcChannels == 1) {
+        return table[LayoutMonoToStereo](dst, src, srcLength, position, step, numSamples, gain, gainStep);
+    }
+    if (dstChannels == 2 && srcChannels >= 2) {
+        return table[LayoutStereo](dst, src, srcLength, position, step, numSamples, gain, gainStep);
+    }
+
+    // 그 외 배치: 출력 채널마다 모노 커널
+    float peak = 0.0f;
+    for (int c = 0; c < dstChannels; ++c) {
+        const S* channelSrc = src[std::min(c, srcChannels - 1)];
+        peak = std::max(peak, table[LayoutMono](dst + c, &channelSrc, srcLength, position, step,
+                                                numSamples, gain, gainStep));
+    }
+    return peak;
+}
+
+} // namespace
+
+float mixUnitStep(float* const* dst, int dstChannels, const float* const* src, int srcChannels,
+                  int numSamples, float gain, float gainStep) {
+    if (numSamples <= 0) return 0.0f;
+    return mixUnitStepWith(kernels().f32, dst, dstChannels, src, srcChannels, numSamples, gain, gainStep);
+}
+
+float mixUnitStep(float* const* dst, int dstChannels, const int16_t* const* src, int srcChannels,
+                  int numSamples, float gain, float gainStep) {
+    if (numSamples <= 0) return 0.0f;
+    return mixUnitStepWith(kernels().i16, dst, dstChannels, src, srcChannels, numSamples,
+                           gain * INT16_SCALE, gainStep * INT16_SCALE);
+}
+
+const char* getInterpolationName(Interpolation interpolation) {
+    switch (interpolation) {
+        case Interpolation::Linear: return "linear";
+        case Interpolation::Cubic:  return "cubic";
+        case Interpolation::Sinc:   return "sinc";
+    }
+    return "cubic";
+}
+
+bool parseInterpolation(const char* name, Interpolation& interpolation) {
+    for (auto candidate : { Interpolation::Linear, Interpolation::Cubic, Interpolation::Sinc }) {
+        if (std::strcmp(name, getInterpolationName(candidate)) == 0) {
+            interpolation = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+float mixResampled(Interpolation interpolation, float* const* dst, int dstChannels,
+                   const float* const* src, int srcChannels, int srcLength,
+                   double position, double step, int numSamples, float gain, float gainStep) {
+    if (numSamples <= 0 || srcLength <= 0 || step <= 0.0) return 0.0f;
+    return mixResampledWith(kernels().f32.resampled[static_cast<int>(interpolation)], dst, dstChannels,
+                            src, srcChannels, srcLength, position, step, numSamples, gain, gainStep);
+}
+
+float mixResampled(Interpolation interpolation, float* const* dst, int dstChannels,
+                   const int16_t* const* src, int srcChannels, int srcLength,
+                   double position, double step, int numSamples, float gain, float gainStep) {
+    if (numSamples <= 0 || srcLength <= 0 || step <= 0.0) return 0.0f;
+    return mixResampledWith(kernels().i16.resampled[static_cast<int>(interpolation)], dst, dstChannels,
+                            src, srcChannels, srcLength, position, step, numSamples,
+                            gain * INT16_SCALE, gainStep * INT16_SCALE);
+}
+
+} // namespace RenderKernels
+} // namespace FXBoard
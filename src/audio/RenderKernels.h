@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+
+namespace FXBoard {
+
+/**
+ * 보이스 렌더링 커널 (블록 단위 SIMD)
+ *
+ * 채널 배치(모노→스테레오, 스테레오→스테레오 등)별로 특수화된 커널을
+ * CPU가 지원하는 명령어 집합(AVX2/SSE2/NEON, 없으면 스칼라)으로 골라 실행
+ * 게인은 블록 안에서 선형으로 변할 수 있음 (gain + i * gainStep, 보이스 교체 페이드용)
+ * 소스는 float 또는 16비트 정수 (int16_t 버전은 로드하면서 float로 넓히고 게인에 1/32768을 포함해 곱함,
+ * 채널 끝 뒤에 한 샘플 여유가 있어야 함 - SampleArena::allocateCompactChannel)
+ *
+ * 모든 함수는 실시간 안전 (할당/락 없음)
+ */
+namespace RenderKernels {
+
+enum class Isa { Scalar, SSE2, AVX2, NEON };
+
+/**
+ * 현재 사용하는 명령어 집합
+ */
+Isa getIsa();
+const char* getIsaName(Isa isa);
+
+/**
+ * 이 CPU에서 쓸 수 있는지
+ */
+bool isSupported(Isa isa);
+
+/**
+ * 명령어 집합 강제 선택 (벤치마크/비교용, 오디오 시작 전에 호출)
+ * @return 지원하지 않으면 false (변경 없음)
+ */
+bool setIsa(Isa isa);
+
+/**
+ * 정수 스텝 믹스 (재생 위치가 한 샘플씩 정확히 증가할 때)
+ * dst[c][i] += src[min(c, srcChannels - 1)][i] * (gain + i * gainStep)
+ * @return 더해진 값의 최대 절댓값 (보이스 음량 추정용)
+ */
+float mixUnitStep(float* const* dst, int dstChannels, const float* const* src, int srcChannels,
+                  int numSamples, float gain, float gainStep);
+float mixUnitStep(float* const* dst, int dstChannels, const int16_t* const* src, int srcChannels,
+                  int numSamples, float gain, float gainStep);
+
+/**
+ * 가변 스텝 보간 방식 (품질/비용 순)
+ * - Linear: 2탭, 가장 싸지만 고음역 에일리어싱
+ * - Cubic: 4점 3차 에르미트
+ * - Sinc: 8탭 windowed-sinc 폴리페이즈 (256위상, 위상 사이 선형 보간)
+ */
+enum class Interpolation { Linear, Cubic, Sinc };
+
+const char* getInterpolationName(Interpolation interpolation);
+
+/**
+ * 이름("linear", "cubic", "sinc")으로 보간 방식 찾기
+ * @return 알 수 없는 이름이면 false (변경 없음)
+ */
+bool parseInterpolation(const char* name, Interpolation& interpolation);
+
+/**
+ * 분수 위치/스텝 보간 믹스 (재생 속도 ≠ 1 또는 위치가 정수가 아닐 때)
+ * 프레임 i는 소스 위치 position + i * step에서 보간, 소스 범위 밖 샘플은 0
+ * @param srcLength 소스 채널 길이
+ * @return 더해진 값의 최대 절댓값
+ */
+float mixResampled(Interpolation interpolation, float* const* dst, int dstChannels,
+                   const float* const* src, int srcChannels, int srcLength,
+                   double position, double step, int numSamples, float gain, float gainStep);
+float mixResampled(Interpolation interpolation, float* const* dst, int dstChannels,
+                   const int16_t* const* src, int srcChannels, int srcLength,
+                   double position, double step, int numSamples, float gain, float gainStep);
+
+} // namespace RenderKernels
+
+} // namespace FXBoard
@@ -0,0 +1,71 @@
+// AVX2 커널 - CMake가 x86에서 이 파일만 -mavx2로 컴파일 (실행 여부는 RenderKernels.cpp가 CPU 확인 후 결정)
+#include "RenderKernelsImpl.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace FXBoard {
+namespace RenderKernels {
+namespace Impl {
+
+#if defined(__AVX2__)
+
+namespace {
+
+struct Avx2Vec {
+    static constexpr int width = 8;
+    using Reg = __m256;
+    static Reg zero() { return _mm256_setzero_ps(); }
+    static Reg set1(float v) { return _mm256_set1_ps(v); }
+    static Reg ramp(float base, float step) {
+        return _mm256_add_ps(_mm256_set1_ps(base),
+                             _mm256_mul_ps(_mm256_set1_ps(step), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7)));
+    }
+    static Reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static Reg load(const int16_t* p) {
+        return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+    }
+    static void store(float* p, Reg v) { _mm256_storeu_ps(p, v); }
+    static Reg add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+    static Reg sub(Reg a, Reg b) { return _mm256_sub_ps(a, b); }
+    static Reg mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+    static Reg abs(Reg a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static Reg max(Reg a, Reg b) { return _mm256_max_ps(a, b); }
+    static float hmax(Reg a) {
+        __m128 m = _mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+        m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+        m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+        return _mm_cvtss_f32(m);
+    }
+    static Reg gather(const float* base, const int* idx, int offset) {
+        const __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx));
+        return _mm256_i32gather_ps(base, _mm256_add_epi32(lanes, _mm256_set1_epi32(offset)), 4);
+    }
+    static Reg gather(const int16_t* base, const int* idx, int offset) {
+        // 2바이트 간격으로 32비트씩 모은 뒤 아래 16비트만 부호 확장 (다음 샘플까지 읽음)
+        const __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx));
+        const __m256i words = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base),
+                                                     _mm256_add_epi32(lanes, _mm256_set1_epi32(offset)), 2);
+        return _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_slli_epi32(words, 16), 16));
+    }
+};
+
+} // namespace
+
+const KernelTable* getAvx2Kernels() {
+    static const KernelTable table = makeKernelTable<Avx2Vec>();
+    return &table;
+}
+
+#else
+
+const KernelTable* getAvx2Kernels() {
+    return nullptr;
+}
+
+#endif
+
+} // namespace Impl
+} // namespace RenderKernels
+} // namespace FXBoard
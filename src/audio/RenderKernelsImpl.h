@@ -0,0 +1,324 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// RenderKernels 내부용: 명령어 집합별 번역 단위가 벡터 타입 V로 인스턴스화
+//
+// V 요구 사항:
+//   V::width, V::Reg
+//   zero(), set1(float), ramp(base, step) = {base, base + step, ...}
+//   load/store (정렬 불필요), add, sub, mul, abs, max, hmax
+//   gather(base, idx, offset) = {base[idx[0] + offset], base[idx[1] + offset], ...}
+//   load/gather의 int16_t 버전: 정수 값을 그대로 float로 넓힘 (1/32768 스케일은 호출하는 쪽 게인에 포함)
+//   int16_t gather는 base[idx + offset + 1]까지 읽을 수 있음 (채널 끝 뒤에 한 샘플 여유)
+//
+// AVX2 번역 단위는 -mavx2로 컴파일되므로 커널 코드는 모두 익명 네임스페이스에 두고
+// 외부 링크를 갖는 인라인 함수(std::min 등)도 쓰지 않음
+// (링커가 AVX2로 컴파일된 복사본을 골라 다른 번역 단위에서 호출하는 것을 방지)
+
+namespace FXBoard {
+namespace RenderKernels {
+namespace Impl {
+
+// S = 소스 샘플 형식 (float 또는 int16_t)
+template <typename S>
+using MixFn = float (*)(float* const* dst, const S* const* src, int numSamples, float gain, float gainStep);
+template <typename S>
+using ResampleFn = float (*)(float* const* dst, const S* const* src, int srcLength,
+                             double position, double step, int numSamples, float gain, float gainStep);
+
+enum Layout { LayoutMono, LayoutMonoToStereo, LayoutStereo, NumLayouts };
+constexpr int NUM_INTERPOLATIONS = 3;  // Interpolation 열거형 순서 (Linear, Cubic, Sinc)
+
+/**
+ * 소스 형식 하나의 커널 묶음 (채널 배치별)
+ */
+template <typename S>
+struct KernelSet {
+    MixFn<S> mono;          // 1 → 1
+    MixFn<S> monoToStereo;  // 1 → 2
+    MixFn<S> stereo;        // 2 → 2
+    ResampleFn<S> resampled[NUM_INTERPOLATIONS][NumLayouts];
+};
+
+/**
+ * 명령어 집합별 커널 묶음
+ */
+struct KernelTable {
+    KernelSet<float> f32;
+    KernelSet<int16_t> i16;  // 16비트 정수 소스 (로드하면서 float로 넓혀 게인과 함께 곱함)
+};
+
+// 짧은 폴리페이즈 sinc 보간 필터 (RenderKernels.cpp에서 시작 시 계산)
+constexpr int SINC_TAPS = 8;
+constexpr int SINC_PHASES = 256;
+extern float sincTable[(SINC_PHASES + 1) * SINC_TAPS];  // 위상별 SINC_TAPS개, 마지막 행은 다음 샘플 위치
+
+// AVX2 커널 (RenderKernelsAVX2.cpp, x86에서만 -mavx2로 컴파일, 아니면 nullptr)
+const KernelTable* getAvx2Kernels();
+
+namespace {
+
+inline float maxf(float a, float b) { return a > b ? a : b; }
+inline float absf(float a) { return std::fabs(a); }
+
+/**
+ * 정수 스텝 게인-누적 커널
+ * 소스 채널을 한 번 읽어 그 소스를 쓰는 모든 출력 채널에 더함 (모노→스테레오는 읽기 한 번)
+ */
+template <typename V, typename S, int SrcChannels, int DstChannels>
+float mixUnitStep(float* const* dst, const S* const* src, int numSamples, float gain, float gainStep) {
+    static_assert(SrcChannels >= 1 && SrcChannels <= DstChannels, "unsupported channel layout");
+    constexpr int W = V::width;
+
+    float* out[DstChannels];
+    const S* in[SrcChannels];
+    for (int c = 0; c < DstChannels; ++c) out[c] = dst[c];
+    for (int c = 0; c < SrcChannels; ++c) in[c] = src[c];
+
+    typename V::Reg g = V::ramp(gain, gainStep);
+    const typename V::Reg gInc = V::set1(gainStep * static_cast<float>(W));
+    typename V::Reg peak = V::zero();
+
+    int i = 0;
+    for (; i + W <= numSamples; i += W) {
+        typename V::Reg x[SrcChannels];
+        for (int c = 0; c < SrcChannels; ++c) {
+            x[c] = V::mul(V::load(in[c] + i), g);
+            peak = V::max(peak, V::abs(x[c]));
+        }
+        for (int c = 0; c < DstChannels; ++c) {
+            float* o = out[c] + i;
+            V::store(o, V::add(V::load(o), x[c < SrcChannels ? c : SrcChannels - 1]));
+        }
+        g = V::add(g, gInc);
+    }
+
+    // 꼬리: 벡터 폭보다 짧게 남은 샘플
+    float result = V::hmax(peak);
+    float gs = gain + gainStep * static_cast<float>(i);
+    for (; i < numSamples; ++i) {
+        float x[SrcChannels];
+        for (int c = 0; c < SrcChannels; ++c) {
+            x[c] = static_cast<float>(in[c][i]) * gs;
+            result = maxf(result, absf(x[c]));
+        }
+        for (int c = 0; c < DstChannels; ++c) {
+            out[c][i] += x[c < SrcChannels ? c : SrcChannels - 1];
+        }
+        gs += gainStep;
+    }
+    return result;
+}
+
+/**
+ * 스칼라 "벡터" (폭 1) - 다른 명령어 집합이 없을 때, 그리고 꼬리/가장자리 처리
+ */
+struct ScalarVec {
+    static constexpr int width = 1;
+    using Reg = float;
+    static Reg zero() { return 0.0f; }
+    static Reg set1(float v) { return v; }
+    static Reg ramp(float base, float) { return base; }
+    static Reg load(const float* p) { return *p; }
+    static Reg load(const int16_t* p) { return static_cast<float>(*p); }
+    static void store(float* p, Reg v) { *p = v; }
+    static Reg add(Reg a, Reg b) { return a + b; }
+    static Reg sub(Reg a, Reg b) { return a - b; }
+    static Reg mul(Reg a, Reg b) { return a * b; }
+    static Reg abs(Reg a) { return absf(a); }
+    static Reg max(Reg a, Reg b) { return maxf(a, b); }
+    static float hmax(Reg a) { return a; }
+    static Reg gather(const float* base, const int* idx, int offset) { return base[idx[0] + offset]; }
+    static Reg gather(const int16_t* base, const int* idx, int offset) { return static_cast<float>(base[idx[0] + offset]); }
+};
+
+/**
+ * 보간기: 벡터 폭만큼의 출력 프레임에 대해
+ * prepare()에서 프레임별 소수 위치로 계수를 준비하고, eval()로 소스 채널마다 보간
+ * LEFT/RIGHT = 정수 위치 앞뒤로 읽는 샘플 수
+ */
+template <typename V>
+struct LinearInterp {
+    static constexpr int LEFT = 0;
+    static constexpr int RIGHT = 1;
+    typename V::Reg frac;
+
+    void prepare(const float* fractions) { frac = V::load(fractions); }
+    template <typename S>
+    typename V::Reg eval(const S* in, const int* idx) const {
+        const auto x0 = V::gather(in, idx, 0);
+        const auto x1 = V::gather(in, idx, 1);
+        return V::add(x0, V::mul(V::sub(x1, x0), frac));
+    }
+};
+
+// 4점 3차 에르미트 (Catmull-Rom)
+template <typename V>
+struct CubicInterp {
+    static constexpr int LEFT = 1;
+    static constexpr int RIGHT = 2;
+    typename V::Reg frac;
+
+    void prepare(const float* fractions) { frac = V::load(fractions); }
+    template <typename S>
+    typename V::Reg eval(const S* in, const int* idx) const {
+        const auto xm1 = V::gather(in, idx, -1);
+        const auto x0 = V::gather(in, idx, 0);
+        const auto x1 = V::gather(in, idx, 1);
+        const auto x2 = V::gather(in, idx, 2);
+        const auto half = V::set1(0.5f);
+        const auto c1 = V::mul(half, V::sub(x1, xm1));
+        const auto c2 = V::sub(V::add(xm1, V::add(x1, x1)), V::add(V::mul(V::set1(2.5f), x0), V::mul(half, x2)));
+        const auto c3 = V::add(V::mul(half, V::sub(x2, xm1)), V::mul(V::set1(1.5f), V::sub(x0, x1)));
+        return V::add(x0, V::mul(frac, V::add(c1, V::mul(frac, V::add(c2, V::mul(frac, c3))))));
+    }
+};
+
+// 8탭 windowed-sinc, 위상 사이는 선형 보간 (계수는 채널 사이에 공유)
+template <typename V>
+struct SincInterp {
+    static constexpr int LEFT = SINC_TAPS / 2 - 1;
+    static constexpr int RIGHT = SINC_TAPS / 2;
+    typename V::Reg coeff[SINC_TAPS];
+
+    void prepare(const float* fractions) {
+        int row[V::width];
+        float rowFrac[V::width];
+        for (int l = 0; l < V::width; ++l) {
+            const float phase = fractions[l] * static_cast<float>(SINC_PHASES);
+            int r = static_cast<int>(phase);
+            r = r < SINC_PHASES - 1 ? r : SINC_PHASES - 1;
+            row[l] = r * SINC_TAPS;
+            rowFrac[l] = phase - static_cast<float>(r);
+        }
+        const auto f = V::load(rowFrac);
+        for (int t = 0; t < SINC_TAPS; ++t) {
+            const auto a = V::gather(sincTable, row, t);
+            const auto b = V::gather(sincTable, row, t + SINC_TAPS);
+            coeff[t] = V::add(a, V::mul(V::sub(b, a), f));
+        }
+    }
+    template <typename S>
+    typename V::Reg eval(const S* in, const int* idx) const {
+        auto sum = V::mul(V::gather(in, idx, -LEFT), coeff[0]);
+        for (int t = 1; t < SINC_TAPS; ++t) {
+            sum = V::add(sum, V::mul(V::gather(in, idx, t - LEFT), coeff[t]));
+        }
+        return sum;
+    }
+};
+
+/**
+ * 가변 스텝 보간 믹스 (피치 변경/레이트 변환)
+ * 모든 탭이 소스 안에 있는 구간은 벡터 경로, 소스 앞뒤 가장자리와 꼬리는 0으로 채운 창으로 스칼라 처리
+ */
+template <typename V, template <typename> class Interp, typename S, int SrcChannels, int DstChannels>
+float mixResampled(float* const* dst, const S* const* src, int srcLength,
+                   double position, double step, int numSamples, float gain, float gainStep) {
+    static_assert(SrcChannels >= 1 && SrcChannels <= DstChannels, "unsupported channel layout");
+    constexpr int W = V::width;
+    constexpr int LEFT = Interp<V>::LEFT;
+    constexpr int RIGHT = Interp<V>::RIGHT;
+    constexpr int TAPS = LEFT + RIGHT + 1;
+
+    float* out[DstChannels];
+    const S* in[SrcChannels];
+    for (int c = 0; c < DstChannels; ++c) out[c] = dst[c];
+    for (int c = 0; c < SrcChannels; ++c) in[c] = src[c];
+
+    // 벡터 경로 구간 [begin, end): LEFT <= 정수 위치 < srcLength - RIGHT
+    auto framesBefore = [&](double limit) {
+        const double frames = std::ceil((limit - position) / step);
+        return frames <= 0.0 ? 0 : (frames >= numSamples ? numSamples : static_cast<int>(frames));
+    };
+    const int begin = framesBefore(static_cast<double>(LEFT));
+    const int end = framesBefore(static_cast<double>(srcLength - RIGHT));
+
+    float result = 0.0f;
+
+    // 가장자리 프레임 하나: 0으로 채운 창을 만들어 스칼라 보간
+    auto edgeFrame = [&](int i) {
+        const double pos = position + i * step;
+        const int index = static_cast<int>(pos);
+        float frac = static_cast<float>(pos - index);
+        const int zero = 0;
+        Interp<ScalarVec> interp;
+        interp.prepare(&frac);
+        const float g = gain + gainStep * static_cast<float>(i);
+
+        float x[SrcChannels];
+        for (int c = 0; c < SrcChannels; ++c) {
+            float window[TAPS];
+            for (int t = 0; t < TAPS; ++t) {
+                const int k = index - LEFT + t;
+                window[t] = (k >= 0 && k < srcLength) ? static_cast<float>(in[c][k]) : 0.0f;
+            }
+            x[c] = interp.eval(window + LEFT, &zero) * g;
+            result = maxf(result, absf(x[c]));
+        }
+        for (int c = 0; c < DstChannels; ++c) {
+            out[c][i] += x[c < SrcChannels ? c : SrcChannels - 1];
+        }
+    };
+
+    int i = 0;
+    for (; i < begin; ++i) edgeFrame(i);
+
+    typename V::Reg peak = V::zero();
+    typename V::Reg g = V::ramp(gain + gainStep * static_cast<float>(i), gainStep);
+    const typename V::Reg gInc = V::set1(gainStep * static_cast<float>(W));
+    for (; i + W <= end; i += W) {
+        int idx[W];
+        float frac[W];
+        for (int l = 0; l < W; ++l) {
+            const double pos = position + (i + l) * step;
+            idx[l] = static_cast<int>(pos);
+            frac[l] = static_cast<float>(pos - idx[l]);
+        }
+
+        Interp<V> interp;
+        interp.prepare(frac);
+        typename V::Reg x[SrcChannels];
+        for (int c = 0; c < SrcChannels; ++c) {
+            x[c] = V::mul(interp.eval(in[c], idx), g);
+            peak = V::max(peak, V::abs(x[c]));
+        }
+        for (int c = 0; c < DstChannels; ++c) {
+            float* o = out[c] + i;
+            V::store(o, V::add(V::load(o), x[c < SrcChannels ? c : SrcChannels - 1]));
+        }
+        g = V::add(g, gInc);
+    }
+    result = maxf(result, V::hmax(peak));
+
+    for (; i < numSamples; ++i) edgeFrame(i);
+    return result;
+}
+
+template <typename V, template <typename> class Interp, typename S>
+void fillResampled(ResampleFn<S> (&fns)[NumLayouts]) {
+    fns[LayoutMono] = &mixResampled<V, Interp, S, 1, 1>;
+    fns[LayoutMonoToStereo] = &mixResampled<V, Interp, S, 1, 2>;
+    fns[LayoutStereo] = &mixResampled<V, Interp, S, 2, 2>;
+}
+
+template <typename V, typename S>
+KernelSet<S> makeKernelSet() {
+    KernelSet<S> set{ &mixUnitStep<V, S, 1, 1>, &mixUnitStep<V, S, 1, 2>, &mixUnitStep<V, S, 2, 2>, {} };
+    fillResampled<V, LinearInterp, S>(set.resampled[0]);
+    fillResampled<V, CubicInterp, S>(set.resampled[1]);
+    fillResampled<V, SincInterp, S>(set.resampled[2]);
+    return set;
+}
+
+template <typename V>
+KernelTable makeKernelTable() {
+    return { makeKernelSet<V, float>(), makeKernelSet<V, int16_t>() };
+}
+
+} // namespace
+
+} // namespace Impl
+} // namespace RenderKernels
+} // namespace FXBoard
@@ -0,0 +1,142 @@
+#include "Resampler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace FXBoard {
+
+namespace {
+
+constexpr double KAISER_BETA = 9.0;
+constexpr double PASSBAND = 0.95;  // 낮은 쪽 나이퀴스트 대비 차단 주파수
+constexpr int MAX_HALF_TAPS = 512;
+
+// 0차 수정 베셀 함수 (카이저 창)
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x * 0.5;
+    for (int k = 1; k < 50; ++k) {
+        term *= halfX / k;
+        const double squared = term * term;
+        sum += squared;
+        if (squared < sum * 1.0e-12) break;
+    }
+    return sum;
+}
+
+} // namespace
+
+Resampler::Resampler(double inputRate, double outputRate) {
+    const auto in = std::max<int64_t>(1, static_cast<int64_t>(std::llround(inputRate)));
+    const auto out = std::max<int64_t>(1, static_cast<int64_t>(std::llround(outputRate)));
+    const int64_t divisor = std::gcd(in, out);
+    upFactor = out / divisor;
+    downFactor = in / divisor;
+
+    if (isIdentity()) return;
+
+    // 다운샘플링이면 출력 나이퀴스트 기준으로 차단하고 필터를 그만큼 길게
+    const double ratio = std::min(1.0, static_cast<double>(upFactor) / static_cast<double>(downFactor));
+    const int halfTaps = std::min(MAX_HALF_TAPS, static_cast<int>(std::ceil(HALF_TAPS / ratio)));
+    numTaps = 2 * halfTaps;
+    numPhases = static_cast<int>(std::min<int64_t>(upFactor, MAX_PHASES));
+    buildTable(PASSBAND * ratio);
+}
+
+void Resampler::buildTable(double cutoff) {
+    const int halfTaps = numTaps / 2;
+    const double i0Beta = besselI0(KAISER_BETA);
+    table.assign(static_cast<size_t>(numPhases + 1) * static_cast<size_t>(numTaps), 0.0f);
+
+    std::vector<double> row(static_cast<size_t>(numTaps));
+    for (int p = 0; p <= numPhases; ++p) {
+        // 출력 시점 = 입력 샘플 i + phase, 탭 j는 입력 샘플 i - halfTaps + 1 + j
+        const double phase = static_cast<double>(p) / numPhases;
+        double sum = 0.0;
+        for (int j = 0; j < numTaps; ++j) {
+            const double t = phase + (halfTaps - 1 - j);
+            const double x = cutoff * t;
+            const double sinc = std::abs(x) < 1.0e-12 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+            const double w = t / halfTaps;
+            const double window = std::abs(w) >= 1.0 ? 0.0 : besselI0(KAISER_BETA * std::sqrt(1.0 - w * w)) / i0Beta;
+            row[static_cast<size_t>(j)] = cutoff * sinc * window;
+            sum += row[static_cast<size_t>(j)];
+        }
+
+        // 위상마다 DC 이득을 1로 (위상별 리플이 잡음으로 들리지 않도록)
+        float* dst = &table[static_cast<size_t>(p) * static_cast<size_t>(numTaps)];
+        for (int j = 0; j < numTaps; ++j) {
+            dst[j] = static_cast<float>(row[static_cast<size_t>(j)] / sum);
+        }
+    }
+}
+
+int Resampler::getOutputLength(int inputLength) const {
+    if (inputLength <= 0) return 0;
+    const int64_t length = (static_cast<int64_t>(inputLength) * upFactor + downFactor - 1) / downFactor;
+    return static_cast<int>(std::min<int64_t>(length, std::numeric_limits<int>::max()));
+}
+
+void Resampler::process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output) const {
+    const int inLength = input.getNumSamples();
+    if (isIdentity()) {
+        output.makeCopyOf(input);
+        return;
+    }
+
+    const int outLength = getOutputLength(inLength);
+    output.setSize(input.getNumChannels(), outLength);
+    for (int ch = 0; ch < input.getNumChannels(); ++ch) {
+        processChannel(input.getReadPointer(ch), inLength, output.getWritePointer(ch), outLength);
+    }
+}
+
+void Resampler::processChannel(const float* in, int inLength, float* out, int outLength) const {
+    const int halfTaps = numTaps / 2;
+    const bool exactPhases = numPhases == upFactor;
+    std::vector<float> blended(static_cast<size_t>(numTaps));
+
+    for (int n = 0; n < outLength; ++n) {
+        // 출력 n의 입력 시점 = n × M / L (정수 연산으로 누적 오차 없음)
+        const int64_t position = static_cast<int64_t>(n) * downFactor;
+        const int64_t index = position / upFactor;
+        const int64_t remainder = position % upFactor;
+
+        const float* coeffs;
+        if (exactPhases) {
+            coeffs = &table[static_cast<size_t>(remainder) * static_cast<size_t>(numTaps)];
+        } else {
+            const double scaled = static_cast<double>(remainder) * numPhases / static_cast<double>(upFactor);
+            const int row = static_cast<int>(scaled);
+            const float frac = static_cast<float>(scaled - row);
+            const float* a = &table[static_cast<size_t>(row) * static_cast<size_t>(numTaps)];
+            const float* b = a + numTaps;
+            for (int j = 0; j < numTaps; ++j) {
+                blended[static_cast<size_t>(j)] = a[j] + (b[j] - a[j]) * frac;
+            }
+            coeffs = blended.data();
+        }
+
+        const int64_t first = index - halfTaps + 1;
+        double sum = 0.0;
+        if (first >= 0 && first + numTaps <= inLength) {
+            const float* x = in + first;
+            for (int j = 0; j < numTaps; ++j) {
+                sum += static_cast<double>(x[j]) * coeffs[j];
+            }
+        } else {
+            // 버퍼 앞/뒤 가장자리: 범위 밖 입력은 0
+            for (int j = 0; j < numTaps; ++j) {
+                const int64_t k = first + j;
+                if (k >= 0 && k < inLength) {
+                    sum += static_cast<double>(in[k]) * coeffs[j];
+                }
+            }
+        }
+        out[n] = static_cast<float>(sum);
+    }
+}
+
+} // namespace FXBoard
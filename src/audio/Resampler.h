@@ -0,0 +1,52 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cstdint>
+#include <vector>
+
+namespace FXBoard {
+
+/**
+ * 샘플레이트 변환기 (로드 시점 전용, 폴리페이즈 windowed-sinc)
+ *
+ * 출력/입력 비율을 기약 분수 L/M으로 보고 L개 위상의 필터 계수를 미리 계산
+ * - 44.1 → 48 kHz (160/147) 같은 일반적인 비율은 정확한 위상으로 계산
+ * - 위상 수가 MAX_PHASES를 넘는 특이한 비율은 인접 위상 사이를 선형 보간
+ * - 카이저 창 (β = 9, 저지대역 약 -90 dB), 차단 주파수는 낮은 쪽 나이퀴스트의 95%
+ * - 다운샘플링은 필터 길이를 비율만큼 늘려 전이 대역 폭을 유지
+ *
+ * 할당이 있으므로 오디오 스레드에서 호출 금지
+ */
+class Resampler {
+public:
+    static constexpr int HALF_TAPS = 48;      // 업샘플링 기준 한쪽 탭 수
+    static constexpr int MAX_PHASES = 2048;
+
+    Resampler(double inputRate, double outputRate);
+
+    /**
+     * 입력 길이에 대한 출력 길이
+     */
+    int getOutputLength(int inputLength) const;
+
+    /**
+     * 버퍼 전체 변환 (output 크기는 자동 설정)
+     */
+    void process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output) const;
+
+    /**
+     * 두 레이트가 같아 변환이 필요 없는지
+     */
+    bool isIdentity() const { return upFactor == downFactor; }
+
+private:
+    void buildTable(double cutoff);
+    void processChannel(const float* in, int inLength, float* out, int outLength) const;
+
+    int64_t upFactor = 1;    // L
+    int64_t downFactor = 1;  // M
+    int numPhases = 1;       // 테이블 행 수 - 1 (마지막 행은 다음 입력 샘플 위치)
+    int numTaps = 2 * HALF_TAPS;
+    std::vector<float> table;  // (numPhases + 1) × numTaps
+};
+
+} // namespace FXBoard
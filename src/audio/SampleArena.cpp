@@ -0,0 +1,211 @@
+#include "SampleArena.h"
+#include <juce_core/juce_core.h>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if JUCE_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace FXBoard {
+
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+SampleArena::~SampleArena() {
+    release();
+}
+
+size_t SampleArena::channelBytes(int numSamples) {
+    return roundUp(static_cast<size_t>(juce::jmax(0, numSamples)) * sizeof(float), ALIGNMENT);
+}
+
+size_t SampleArena::compactChannelBytes(int numSamples) {
+    return roundUp((static_cast<size_t>(juce::jmax(0, numSamples)) + 1) * sizeof(int16_t), ALIGNMENT);
+}
+
+#if JUCE_LINUX
+
+bool SampleArena::allocate(size_t bytes, bool hugePages) {
+    release();
+    bytes = juce::jmax(bytes, ALIGNMENT);
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    void* ptr = MAP_FAILED;
+    if (hugePages) {
+        // 예약된 hugetlbfs 페이지 (vm.nr_hugepages), 없으면 실패하므로 아래에서 일반 페이지로 다시 시도
+        mappedSize = roundUp(bytes, HUGE_PAGE_SIZE);
+        ptr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        hugePageBacked = ptr != MAP_FAILED;
+    }
+    if (ptr == MAP_FAILED) {
+        mappedSize = roundUp(bytes, hugePages ? HUGE_PAGE_SIZE : pageSize);
+        ptr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            juce::Logger::writeToLog(juce::String("Error: sample arena mmap of ") + juce::String(static_cast<juce::int64>(mappedSize)) +
+                                     " bytes failed (" + strerror(errno) + ")");
+            mappedSize = 0;
+            return false;
+        }
+        if (hugePages) {
+            // 투명 huge page 요청 (transparent_hugepage가 madvise/always일 때만 효과)
+            madvise(ptr, mappedSize, MADV_HUGEPAGE);
+            juce::Logger::writeToLog("No reserved huge pages for the sample arena, using transparent huge pages if enabled");
+        }
+    }
+
+    base = static_cast<char*>(ptr);
+    size = mappedSize;
+    used = 0;
+    mapped = true;
+
+    locked = mlock(base, mappedSize) == 0;
+    if (!locked) {
+        juce::Logger::writeToLog(juce::String("Warning: mlock of sample arena failed (") + strerror(errno) +
+                                 "), samples may be paged out");
+        juce::Logger::writeToLog("  Raise memlock, e.g. '@audio - memlock unlimited' in /etc/security/limits.conf");
+    }
+
+    // 모든 페이지를 미리 매핑 (잠금에 실패했어도 첫 트리거가 폴트를 맞지 않도록)
+    auto* bytesPtr = static_cast<volatile char*>(base);
+    for (size_t i = 0; i < mappedSize; i += pageSize) {
+        bytesPtr[i] = 0;
+    }
+    return true;
+}
+
+bool SampleArena::mapFile(const juce::File& file) {
+    release();
+    const int fd = open(file.getFullPathName().toRawUTF8(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        juce::Logger::writeToLog(juce::String("Cannot open ") + file.getFullPathName() + " (" + strerror(errno) + ")");
+        return false;
+    }
+
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    // MAP_POPULATE: 페이지 캐시에서 미리 매핑 (첫 트리거에 폴트 없음)
+    const auto length = static_cast<size_t>(info.st_size);
+    void* ptr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        juce::Logger::writeToLog(juce::String("Cannot map ") + file.getFullPathName() + " (" + strerror(errno) + ")");
+        return false;
+    }
+
+    base = static_cast<char*>(ptr);
+    size = used = mappedSize = length;
+    mapped = true;
+    fileBacked = true;
+
+    locked = mlock(base, mappedSize) == 0;
+    if (!locked) {
+        juce::Logger::writeToLog(juce::String("Warning: mlock of sample bank failed (") + strerror(errno) +
+                                 "), samples may be paged out");
+    }
+    return true;
+}
+
+void SampleArena::release() {
+    if (base != nullptr) {
+        if (mapped) {
+            if (locked) munlock(base, mappedSize);
+            munmap(base, mappedSize);
+        } else {
+            ::operator delete(base, std::align_val_t(ALIGNMENT));
+        }
+    }
+    base = nullptr;
+    size = mappedSize = used = 0;
+    locked = hugePageBacked = mapped = fileBacked = false;
+}
+
+void SampleArena::discard(const void* ptr, size_t bytes) {
+    const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto start = (reinterpret_cast<uintptr_t>(ptr) + pageSize - 1) / pageSize * pageSize;
+    const auto end = (reinterpret_cast<uintptr_t>(ptr) + bytes) / pageSize * pageSize;
+    if (!mapped || hugePageBacked || end <= start) return;
+
+    // 파일 매핑이면 다시 접근할 때 파일에서, 익명 매핑이면 0으로 채워짐
+    auto* begin = reinterpret_cast<void*>(start);
+    if (locked) munlock(begin, end - start);
+    madvise(begin, end - start, MADV_DONTNEED);
+}
+
+#else
+
+// 다른 플랫폼 - 정렬된 힙 할당 (잠금/huge page 없음)
+bool SampleArena::allocate(size_t bytes, bool) {
+    release();
+    bytes = roundUp(juce::jmax(bytes, ALIGNMENT), ALIGNMENT);
+    base = static_cast<char*>(::operator new(bytes, std::align_val_t(ALIGNMENT), std::nothrow));
+    if (base == nullptr) return false;
+    std::memset(base, 0, bytes);
+    size = mappedSize = bytes;
+    used = 0;
+    return true;
+}
+
+bool SampleArena::mapFile(const juce::File& file) {
+    // 매핑 대신 정렬된 힙으로 읽어 들임
+    const auto length = static_cast<size_t>(juce::jmax<juce::int64>(0, file.getSize()));
+    juce::FileInputStream in(file);
+    if (length == 0 || in.failedToOpen() || !allocate(length, false)) return false;
+    if (static_cast<size_t>(in.read(base, static_cast<int>(length))) != length) {
+        release();
+        return false;
+    }
+    size = used = length;
+    fileBacked = true;
+    return true;
+}
+
+void SampleArena::release() {
+    if (base != nullptr) {
+        ::operator delete(base, std::align_val_t(ALIGNMENT));
+    }
+    base = nullptr;
+    size = mappedSize = used = 0;
+    locked = hugePageBacked = mapped = fileBacked = false;
+}
+
+void SampleArena::discard(const void*, size_t) {
+    // 힙 할당은 일부만 반납할 수 없음
+}
+
+#endif
+
+float* SampleArena::allocateChannel(int numSamples) {
+    const size_t bytes = channelBytes(numSamples);
+    if (base == nullptr || used + bytes > size) return nullptr;
+    auto* channel = reinterpret_cast<float*>(base + used);
+    used += bytes;
+    return channel;
+}
+
+int16_t* SampleArena::allocateCompactChannel(int numSamples) {
+    const size_t bytes = compactChannelBytes(numSamples);
+    if (base == nullptr || used + bytes > size) return nullptr;
+    auto* channel = reinterpret_cast<int16_t*>(base + used);
+    channel[juce::jmax(0, numSamples)] = 0;
+    used += bytes;
+    return channel;
+}
+
+} // namespace FXBoard
@@ -0,0 +1,87 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace FXBoard {
+
+/**
+ * 샘플 PCM 전용 연속 메모리 영역
+ *
+ * 로드한 샘플 전체를 한 번에 담는 크기로 할당하고 채널마다 64바이트 정렬로 잘라 씀 (bump 할당)
+ * - mmap으로 잡고 mlock으로 잠가 페이지 아웃되지 않음 (권한이 없으면 경고만 남기고 계속)
+ * - 할당 직후 모든 페이지를 미리 터치하므로 첫 트리거에서 페이지 폴트가 나지 않음
+ * - 선택적으로 huge page 사용 (hugetlbfs 예약 페이지, 없으면 투명 huge page 요청)
+ * - 샘플 뱅크 파일을 읽기 전용으로 매핑해 같은 방식으로 잠글 수도 있음 (mapFile)
+ *
+ * 할당/해제는 오디오 스레드 밖에서만
+ */
+class SampleArena {
+public:
+    static constexpr size_t ALIGNMENT = 64;  // 캐시 라인 (AVX2 로드 경계)
+
+    SampleArena() = default;
+    ~SampleArena();
+
+    SampleArena(const SampleArena&) = delete;
+    SampleArena& operator=(const SampleArena&) = delete;
+
+    /**
+     * 영역 할당 (기존 영역은 해제)
+     * @param bytes 필요한 크기 (channelBytes()의 합)
+     * @param hugePages huge page 요청
+     * @return 메모리를 얻지 못하면 false (잠금 실패는 경고만)
+     */
+    bool allocate(size_t bytes, bool hugePages);
+
+    /**
+     * 파일 전체를 읽기 전용으로 매핑하고 잠금 (기존 영역은 해제)
+     * @return 열거나 매핑하지 못하면 false
+     */
+    bool mapFile(const juce::File& file);
+
+    /**
+     * 채널 하나 분량 잘라 주기
+     * @return 남은 공간이 부족하면 nullptr
+     */
+    float* allocateChannel(int numSamples);
+
+    /**
+     * int16 채널 하나 분량 잘라 주기 (끝 뒤에 0인 여유 샘플 하나, SIMD gather가 읽음)
+     * @return 남은 공간이 부족하면 nullptr
+     */
+    int16_t* allocateCompactChannel(int numSamples);
+
+    void release();
+
+    /**
+     * 영역 안의 구간을 더 쓰지 않음: 잠금을 풀고 페이지를 반납 (스트리밍 샘플의 tail)
+     * 구간 안에 완전히 들어가는 페이지만 반납하므로 앞뒤 데이터는 그대로
+     */
+    void discard(const void* ptr, size_t bytes);
+
+    /**
+     * 채널 하나가 차지하는 크기 (정렬 포함)
+     */
+    static size_t channelBytes(int numSamples);
+    static size_t compactChannelBytes(int numSamples);
+
+    const char* getData() const { return base; }
+    size_t getSize() const { return size; }
+    size_t getUsed() const { return used; }
+    bool isLocked() const { return locked; }
+    bool usesHugePages() const { return hugePageBacked; }
+    bool isFileMapping() const { return fileBacked; }
+
+private:
+    char* base = nullptr;
+    size_t size = 0;         // 사용 가능한 크기
+    size_t mappedSize = 0;   // 실제 매핑 크기 (페이지 단위로 올림)
+    size_t used = 0;
+    bool locked = false;
+    bool hugePageBacked = false;
+    bool mapped = false;     // false = 힙 할당 (mmap 미지원 플랫폼)
+    bool fileBacked = false;
+};
+
+} // namespace FXBoard
@@ -0,0 +1,213 @@
+#include "SampleBank.h"
+#include "SampleArena.h"
+#include "SampleManager.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace FXBoard {
+namespace SampleBank {
+
+namespace {
+
+constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+
+uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+size_t alignUp(size_t value) {
+    return (value + SampleArena::ALIGNMENT - 1) / SampleArena::ALIGNMENT * SampleArena::ALIGNMENT;
+}
+
+uint64_t hashImage(const char* data, size_t size) {
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    header.contentHash = 0;
+    const uint64_t headerHash = hashBytes(&header, sizeof(Header));
+    return hashBytes(data + sizeof(Header), size - sizeof(Header), headerHash);
+}
+
+} // namespace
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t lanes[4] = { seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 };
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int lane = 0; lane < 4; ++lane) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i + lane * 8, sizeof(word));
+            lanes[lane] = rotl(lanes[lane] + word * PRIME2, 31) * PRIME1;
+        }
+    }
+
+    uint64_t hash = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18) + size;
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    hash ^= hash >> 33;
+    hash *= PRIME2;
+    hash ^= hash >> 29;
+    hash *= PRIME1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t hashSources(const std::vector<juce::File>& files, double sampleRate) {
+    std::vector<juce::File> sorted(files);
+    std::sort(sorted.begin(), sorted.end(), [](const juce::File& a, const juce::File& b) {
+        return a.getFileName() < b.getFileName();
+    });
+
+    uint64_t hash = hashBytes(&VERSION, sizeof(VERSION));
+    const auto rate = static_cast<int64_t>(sampleRate + 0.5);
+    hash = hashBytes(&rate, sizeof(rate), hash);
+    for (const auto& file : sorted) {
+        const juce::String name = file.getFileName();
+        const int64_t stats[2] = { file.getSize(), file.getLastModificationTime().toMilliseconds() };
+        hash = hashBytes(name.toRawUTF8(), std::strlen(name.toRawUTF8()), hash);
+        hash = hashBytes(stats, sizeof(stats), hash);
+    }
+    return hash;
+}
+
+bool write(const juce::File& file, const std::vector<const Sample*>& samples, double sampleRate,
+           uint64_t sourceHash, juce::String& error) {
+    const size_t indexOffset = sizeof(Header);
+    const size_t dataOffset = alignUp(indexOffset + samples.size() * sizeof(IndexEntry));
+
+    size_t fileSize = dataOffset;
+    for (const auto* sample : samples) {
+        const int numChannels = sample->buffer.getNumChannels();
+        if (numChannels < 1 || numChannels > MAX_CHANNELS) {
+            error = sample->id + ": unsupported channel count " + juce::String(numChannels);
+            return false;
+        }
+        if (std::abs(sample->sampleRate - sampleRate) >= 0.5) {
+            error = sample->id + " is at " + juce::String(sample->sampleRate, 0) + " Hz, bank is " +
+                    juce::String(sampleRate, 0) + " Hz";
+            return false;
+        }
+        if (std::strlen(sample->id.toRawUTF8()) >= static_cast<size_t>(MAX_NAME_BYTES)) {
+            error = sample->id + ": name longer than " + juce::String(MAX_NAME_BYTES - 1) + " bytes";
+            return false;
+        }
+        fileSize += SampleArena::channelBytes(sample->buffer.getNumSamples()) * static_cast<size_t>(numChannels);
+    }
+
+    // 파일 이미지를 메모리에 만든 뒤 해시를 채워 한 번에 기록 (패딩은 0)
+    juce::MemoryBlock image(fileSize, true);
+    auto* data = static_cast<char*>(image.getData());
+
+    Header header {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.numSamples = static_cast<uint32_t>(samples.size());
+    header.sampleRate = sampleRate;
+    header.sourceHash = sourceHash;
+    header.indexOffset = indexOffset;
+    header.dataOffset = dataOffset;
+    header.fileSize = fileSize;
+    std::memcpy(data, &header, sizeof(Header));
+
+    size_t offset = dataOffset;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const Sample& sample = *samples[i];
+        IndexEntry entry {};
+        std::strncpy(entry.name, sample.id.toRawUTF8(), MAX_NAME_BYTES - 1);
+        entry.numChannels = static_cast<uint32_t>(sample.buffer.getNumChannels());
+        entry.numFrames = static_cast<uint32_t>(sample.buffer.getNumSamples());
+        entry.gain = sample.gain;
+        entry.sourceSampleRate = sample.sourceSampleRate;
+        entry.dataOffset = offset;
+        std::memcpy(data + indexOffset + i * sizeof(IndexEntry), &entry, sizeof(IndexEntry));
+
+        for (int ch = 0; ch < sample.buffer.getNumChannels(); ++ch) {
+            std::memcpy(data + offset, sample.buffer.getReadPointer(ch),
+                        static_cast<size_t>(sample.buffer.getNumSamples()) * sizeof(float));
+            offset += SampleArena::channelBytes(sample.buffer.getNumSamples());
+        }
+    }
+
+    header.contentHash = hashImage(data, fileSize);
+    std::memcpy(data, &header, sizeof(Header));
+
+    // 실행 중인 다른 인스턴스가 매핑한 뱅크를 덮어쓰지 않도록 새 파일로 교체
+    const juce::File temp = file.getSiblingFile(file.getFileName() + ".tmp");
+    {
+        juce::FileOutputStream out(temp);
+        if (out.failedToOpen()) {
+            error = "cannot write " + temp.getFullPathName();
+            return false;
+        }
+        out.setPosition(0);
+        out.truncate();
+        if (!out.write(data, fileSize)) {
+            error = "write failed: " + temp.getFullPathName();
+            temp.deleteFile();
+            return false;
+        }
+        out.flush();
+    }
+    if (!temp.moveFileTo(file)) {
+        error = "cannot replace " + file.getFullPathName();
+        temp.deleteFile();
+        return false;
+    }
+    return true;
+}
+
+bool validate(const void* data, size_t size, juce::String& error) {
+    if (size < sizeof(Header)) {
+        error = "file too small";
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    if (header.magic != MAGIC) {
+        error = "not an FXBoard sample bank";
+        return false;
+    }
+    if (header.version != VERSION) {
+        error = "unsupported bank version " + juce::String(header.version);
+        return false;
+    }
+    if (header.fileSize != size) {
+        error = "size mismatch (truncated?)";
+        return false;
+    }
+    if (header.indexOffset < sizeof(Header) || header.dataOffset % SampleArena::ALIGNMENT != 0 ||
+        header.indexOffset + static_cast<uint64_t>(header.numSamples) * sizeof(IndexEntry) > header.dataOffset ||
+        header.dataOffset > size) {
+        error = "corrupt header";
+        return false;
+    }
+
+    const auto* bytes = static_cast<const char*>(data);
+    for (uint32_t i = 0; i < header.numSamples; ++i) {
+        IndexEntry entry;
+        std::memcpy(&entry, bytes + header.indexOffset + i * sizeof(IndexEntry), sizeof(IndexEntry));
+        const uint64_t length = static_cast<uint64_t>(SampleArena::channelBytes(static_cast<int>(entry.numFrames))) * entry.numChannels;
+        if (entry.name[MAX_NAME_BYTES - 1] != '\0' || entry.numChannels < 1 || entry.numChannels > MAX_CHANNELS ||
+            entry.numFrames > static_cast<uint32_t>(std::numeric_limits<int>::max()) ||
+            entry.dataOffset < header.dataOffset || entry.dataOffset % SampleArena::ALIGNMENT != 0 ||
+            entry.dataOffset + length > size) {
+            error = "corrupt index entry " + juce::String(static_cast<int>(i));
+            return false;
+        }
+    }
+
+    if (hashImage(bytes, size) != header.contentHash) {
+        error = "content hash mismatch";
+        return false;
+    }
+    return true;
+}
+
+} // namespace SampleBank
+} // namespace FXBoard
@@ -0,0 +1,79 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <cstdint>
+#include <vector>
+
+namespace FXBoard {
+
+struct Sample;
+
+/**
+ * 미리 처리한 샘플 뱅크 파일 (.fxbank)
+ *
+ * 디바이스 레이트로 변환하고 페이드 인까지 적용한 float PCM을 담아 두고 mmap해서 복사 없이 재생
+ * 헤더 64바이트 → 인덱스 (샘플당 96바이트) → PCM (채널마다 64바이트 정렬, SampleArena와 같은 배치)
+ * 호스트 바이트 순서 그대로 기록 (리틀 엔디언 기준, 순서가 다른 호스트에서는 매직이 맞지 않아 거부)
+ *
+ * sourceHash = 원본 파일 이름/크기/수정 시각 + 레이트 + 포맷 버전 (디코딩 없이 계산, 낡은 뱅크 판별)
+ * contentHash = 헤더(해시 필드 제외) + 인덱스 + PCM (잘리거나 손상된 파일 판별)
+ */
+namespace SampleBank {
+
+constexpr uint32_t MAGIC = 0x4B425846;  // "FXBK"
+constexpr uint32_t VERSION = 1;
+constexpr int MAX_NAME_BYTES = 64;     // NUL 포함
+constexpr int MAX_CHANNELS = 32;       // AudioBuffer가 채널 포인터를 할당 없이 담는 수
+
+struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t numSamples;
+    uint32_t reserved;
+    double sampleRate;       // PCM 레이트
+    uint64_t sourceHash;
+    uint64_t contentHash;
+    uint64_t indexOffset;
+    uint64_t dataOffset;
+    uint64_t fileSize;
+};
+
+struct IndexEntry {
+    char name[MAX_NAME_BYTES];  // UTF-8 샘플 ID
+    uint32_t numChannels;
+    uint32_t numFrames;
+    float gain;
+    uint32_t reserved;
+    double sourceSampleRate;
+    uint64_t dataOffset;        // 첫 채널 위치 (파일 시작 기준), 채널 간격 = SampleArena::channelBytes(numFrames)
+};
+
+static_assert(sizeof(Header) == 64, "fxbank header layout");
+static_assert(sizeof(IndexEntry) == 96, "fxbank index layout");
+
+/**
+ * 64비트 비암호 해시 (8바이트 단위 4레인, 수 GB/s)
+ */
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+/**
+ * 원본 파일 목록의 해시 (파일 순서와 무관)
+ */
+uint64_t hashSources(const std::vector<juce::File>& files, double sampleRate);
+
+/**
+ * 샘플들을 뱅크 파일로 기록 (임시 파일에 쓴 뒤 이름을 바꿔 교체)
+ * 모든 샘플이 sampleRate로 변환되어 있어야 함
+ * @return 실패 시 false, error에 이유
+ */
+bool write(const juce::File& file, const std::vector<const Sample*>& samples, double sampleRate,
+           uint64_t sourceHash, juce::String& error);
+
+/**
+ * 메모리에 올린 뱅크의 헤더/인덱스 범위/contentHash 검사
+ * @return 실패 시 false, error에 이유
+ */
+bool validate(const void* data, size_t size, juce::String& error);
+
+} // namespace SampleBank
+
+} // namespace FXBoard
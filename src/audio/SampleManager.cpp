@@ -1,7 +1,123 @@
 #include "SampleManager.h"
+#include "VoiceRenderPool.h"
+#include "RenderKernels.h"
+#include "Resampler.h"
+#include "SampleBank.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <system_error>
 
 namespace FXBoard {
 
+namespace {
+
+size_t arenaBytes(const juce::AudioBuffer<float>& buffer) {
+    return SampleArena::channelBytes(buffer.getNumSamples()) * static_cast<size_t>(buffer.getNumChannels());
+}
+
+size_t arenaBytes(int numChannels, int numFrames, bool compact) {
+    return (compact ? SampleArena::compactChannelBytes(numFrames) : SampleArena::channelBytes(numFrames)) *
+           static_cast<size_t>(numChannels);
+}
+
+// int16으로 줄여도 잘리지 않음 (변환 후 샘플 사이 오버슈트로 ±1을 넘으면 float 그대로)
+bool fitsInt16(const juce::AudioBuffer<float>& buffer) {
+    return buffer.getMagnitude(0, buffer.getNumSamples()) <= 1.0f;
+}
+
+// int16 PCM을 float 힙 버퍼로 펼침
+void expandCompact(const CompactPcm& compact, juce::AudioBuffer<float>& buffer) {
+    buffer.setSize(compact.numChannels, compact.numFrames);
+    for (int ch = 0; ch < compact.numChannels; ++ch) {
+        const int16_t* in = compact.channels[ch];
+        float* out = buffer.getWritePointer(ch);
+        for (int i = 0; i < compact.numFrames; ++i) {
+            out[i] = static_cast<float>(in[i]) * (1.0f / 32768.0f);
+        }
+    }
+}
+
+// source를 아레나로 복사하고 view가 복사본을 가리키게 함 (source와 view가 같은 버퍼여도 됨)
+bool copyToArena(SampleArena& arena, const juce::AudioBuffer<float>& source, juce::AudioBuffer<float>& view) {
+    const int numChannels = source.getNumChannels();
+    const int numSamples = source.getNumSamples();
+    std::vector<float*> channels(static_cast<size_t>(numChannels));
+    for (int ch = 0; ch < numChannels; ++ch) {
+        channels[static_cast<size_t>(ch)] = arena.allocateChannel(numSamples);
+        if (channels[static_cast<size_t>(ch)] == nullptr) return false;
+        std::memcpy(channels[static_cast<size_t>(ch)], source.getReadPointer(ch),
+                    static_cast<size_t>(numSamples) * sizeof(float));
+    }
+    view.setDataToReferTo(channels.data(), numChannels, numSamples);
+    return true;
+}
+
+// source(float 또는 int16)를 아레나로 옮기며 compact면 int16, 아니면 float로 저장
+// 결과는 view(float) 또는 compactView(int16) 중 하나에만 남고 다른 쪽은 비움 (source와 view가 같아도 됨)
+bool packToArena(SampleArena& arena, const juce::AudioBuffer<float>& source, const CompactPcm& compactSource,
+                 bool compact, juce::AudioBuffer<float>& view, CompactPcm& compactView) {
+    if (!compact) {
+        if (compactSource.numFrames > 0) {
+            juce::AudioBuffer<float> widened;
+            expandCompact(compactSource, widened);
+            compactView = {};
+            return copyToArena(arena, widened, view);
+        }
+        compactView = {};
+        return copyToArena(arena, source, view);
+    }
+    
+    CompactPcm packed;
+    packed.numChannels = compactSource.numFrames > 0 ? compactSource.numChannels : source.getNumChannels();
+    packed.numFrames = compactSource.numFrames > 0 ? compactSource.numFrames : source.getNumSamples();
+    for (int ch = 0; ch < packed.numChannels; ++ch) {
+        int16_t* out = arena.allocateCompactChannel(packed.numFrames);
+        if (out == nullptr) return false;
+        if (compactSource.numFrames > 0) {
+            std::memcpy(out, compactSource.channels[ch], static_cast<size_t>(packed.numFrames) * sizeof(int16_t));
+        } else {
+            // 16비트 원본은 디코딩 값이 정확히 n / 32768이므로 그대로 돌아감 (페이드 인/변환 구간만 반올림)
+            const float* in = source.getReadPointer(ch);
+            for (int i = 0; i < packed.numFrames; ++i) {
+                out[i] = static_cast<int16_t>(juce::jlimit(-32768L, 32767L, std::lrint(in[i] * 32768.0f)));
+            }
+        }
+        packed.channels[ch] = out;
+    }
+    compactView = packed;
+    view = juce::AudioBuffer<float>();
+    return true;
+}
+
+// 파일 전체를 float로 디코딩하고 시작 부분에 짧은 페이드 인 (클릭 방지)
+// bits = 원본의 정수 비트 수 (float 원본이면 0)
+bool decodeFile(juce::AudioFormatManager& formats, const juce::File& file,
+                juce::AudioBuffer<float>& buffer, double& sampleRate, int& bits) {
+    std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+    if (reader == nullptr) {
+        return false;
+    }
+    
+    sampleRate = reader->sampleRate;
+    bits = reader->usesFloatingPointData ? 0 : static_cast<int>(reader->bitsPerSample);
+    buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+    reader->read(&buffer, 0, static_cast<int>(reader->lengthInSamples), 0, true, true);
+    
+    int fadeLength = juce::jmin(128, buffer.getNumSamples());
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+        auto* data = buffer.getWritePointer(ch);
+        for (int i = 0; i < fadeLength; ++i) {
+            float gain = static_cast<float>(i) / static_cast<float>(fadeLength);
+            data[i] *= gain;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 SampleManager::SampleManager() {
     formatManager.registerBasicFormats();
 }
@@ -16,35 +132,42 @@ bool SampleManager::loadSample(const juce::String& id, const juce::File& filePat
         return false;
     }
     
-    std::unique_ptr<juce::AudioFormatReader> reader(
-        formatManager.createReaderFor(filePath));
-    
-    if (reader == nullptr) {
+    auto sample = std::make_unique<Sample>();
+    sample->id = id;
+    if (!decodeFile(formatManager, filePath, sample->buffer, sample->sampleRate, sample->sourceBits)) {
         juce::Logger::writeToLog("Failed to create reader for: " + filePath.getFullPathName());
         return false;
     }
+    sample->sourceSampleRate = sample->sampleRate;
     
-    auto sample = std::make_unique<Sample>();
-    sample->id = id;
-    sample->sampleRate = reader->sampleRate;
-    sample->buffer.setSize(static_cast<int>(reader->numChannels), 
-                          static_cast<int>(reader->lengthInSamples));
-    
-    reader->read(&sample->buffer, 0, static_cast<int>(reader->lengthInSamples), 
-                 0, true, true);
+    juce::String rateInfo;
+    if (resampleToTarget(*sample)) {
+        rateInfo = " (" + juce::String(sample->sourceSampleRate, 0) + " -> " + juce::String(sample->sampleRate, 0) + " Hz)";
+    }
+    sample->stream = splitTail(id, sample->buffer, sample->sampleRate);
+    if (sample->stream != nullptr) {
+        rateInfo += ", streamed";
+    }
     
-    // 시작 부분에 짧은 페이드-인 (클릭 방지)
-    int fadeLength = juce::jmin(128, sample->buffer.getNumSamples());
-    for (int ch = 0; ch < sample->buffer.getNumChannels(); ++ch) {
-        auto* data = sample->buffer.getWritePointer(ch);
-        for (int i = 0; i < fadeLength; ++i) {
-            float gain = static_cast<float>(i) / static_cast<float>(fadeLength);
-            data[i] *= gain;
-        }
+    samples[id] = std::move(sample);
+    juce::Logger::writeToLog("Loaded sample: " + id + " from " + filePath.getFileName() + rateInfo);
+    return true;
+}
+
+bool SampleManager::addSample(const juce::String& id, const juce::AudioBuffer<float>& buffer, double sampleRate) {
+    if (buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0) {
+        return false;
     }
     
+    auto sample = std::make_unique<Sample>();
+    sample->id = id;
+    sample->sampleRate = sampleRate;
+    sample->sourceSampleRate = sampleRate;
+    sample->buffer = buffer;
+    resampleToTarget(*sample);
+    sample->stream = splitTail(id, sample->buffer, sample->sampleRate);
+    
     samples[id] = std::move(sample);
-    juce::Logger::writeToLog("Loaded sample: " + id + " from " + filePath.getFileName());
     return true;
 }
 
@@ -57,7 +180,603 @@ const Sample* SampleManager::getSample(const juce::String& id) const {
 }
 
 void SampleManager::clear() {
+    cancelLoading();
+    finishConversion();
     samples.clear();
+    arena.reset();
+    streamer.clearSources();
+}
+
+void SampleManager::loadSamplesAsync(const std::vector<std::pair<juce::String, juce::File>>& files, int numThreads) {
+    cancelLoading();
+    finishConversion();
+    
+    // 샘플 항목과 슬롯을 미리 만들어 두므로 로드 중에는 samples/loadSlots 구조가 바뀌지 않음
+    for (const auto& [id, file] : files) {
+        const bool duplicate = std::any_of(loadSlots.begin(), loadSlots.end(),
+                                           [&id = id](const auto& slot) { return slot->sample->id == id; });
+        if (duplicate) continue;
+        auto sample = std::make_unique<Sample>();
+        sample->id = id;
+        auto slot = std::make_unique<LoadSlot>();
+        slot->sample = sample.get();
+        slot->file = file;
+        loadSlots.push_back(std::move(slot));
+        samples[id] = std::move(sample);
+    }
+    
+    loadStats = {};
+    loadStats.numFiles = static_cast<int>(loadSlots.size());
+    if (loadSlots.empty()) return;
+    
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    numThreads = juce::jlimit(1, static_cast<int>(loadSlots.size()), numThreads);
+    
+    loading = true;
+    loadRate.store(targetSampleRate, std::memory_order_relaxed);
+    loadStartMs = juce::Time::getMillisecondCounterHiRes();
+    for (int i = 0; i < numThreads; ++i) {
+        try {
+            loadThreads.emplace_back([this] { loadWorker(); });
+        } catch (const std::system_error&) {
+            break;  // 스레드를 더 만들 수 없으면 있는 것으로 (하나도 없으면 아래에서 직접)
+        }
+    }
+    loadStats.numThreads = static_cast<int>(loadThreads.size());
+    if (loadThreads.empty()) {
+        loadStats.numThreads = 1;
+        loadWorker();
+    }
+}
+
+void SampleManager::loadWorker() {
+    // 포맷 리더는 스레드마다 따로 생성
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    
+    for (;;) {
+        const size_t index = nextLoadSlot.fetch_add(1, std::memory_order_relaxed);
+        if (index >= loadSlots.size() || cancelLoad.load(std::memory_order_relaxed)) return;
+        
+        LoadSlot& slot = *loadSlots[index];
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+        bool decoded = slot.file.existsAsFile() && decodeFile(formats, slot.file, slot.buffer, slot.sourceSampleRate,
+                                                                  slot.sourceBits);
+        if (decoded) {
+            slot.sampleRate = slot.sourceSampleRate;
+            const double rate = loadRate.load(std::memory_order_relaxed);
+            if (rate > 0.0 && std::abs(slot.sampleRate - rate) >= 0.5) {
+                Resampler resampler(slot.sampleRate, rate);
+                juce::AudioBuffer<float> resampled;
+                resampler.process(slot.buffer, resampled);
+                slot.buffer = std::move(resampled);
+                slot.sampleRate = rate;
+            }
+            decoded = slot.buffer.getNumSamples() > 0 && slot.buffer.getNumChannels() > 0;
+            if (decoded) {
+                slot.stream = splitTail(slot.sample->id, slot.buffer, slot.sampleRate);
+            }
+        }
+        slot.finishedMs = juce::Time::getMillisecondCounterHiRes();
+        slot.decodeMs = slot.finishedMs - startMs;
+        
+        slot.state.store(decoded ? LoadDecoded : LoadFailed, std::memory_order_release);
+        numLoadsDone.fetch_add(1, std::memory_order_release);
+    }
+}
+
+int SampleManager::applyLoadedSamples() {
+    const int done = numLoadsDone.load(std::memory_order_acquire);
+    if (done == loadsSeen) return 0;
+    
+    // 교환만 하므로 슬롯에는 샘플의 빈 버퍼가 남음 (해제는 다음 로드나 clear() 때 메인 스레드에서)
+    int applied = 0;
+    for (auto& slot : loadSlots) {
+        if (slot->state.load(std::memory_order_acquire) != LoadDecoded) continue;
+        Sample* sample = slot->sample;
+        std::swap(sample->buffer, slot->buffer);
+        sample->sampleRate = slot->sampleRate;
+        sample->sourceSampleRate = slot->sourceSampleRate;
+        sample->sourceBits = slot->sourceBits;
+        sample->stream = slot->stream;
+        slot->state.store(LoadApplied, std::memory_order_relaxed);
+        ++applied;
+    }
+    loadsSeen = done;
+    if (applied > 0) {
+        numLoadsApplied.fetch_add(applied, std::memory_order_release);
+    }
+    return applied;
+}
+
+void SampleManager::waitForSamples(const juce::StringArray& ids) {
+    std::vector<const LoadSlot*> wanted;
+    for (const auto& slot : loadSlots) {
+        if (ids.contains(slot->sample->id)) {
+            wanted.push_back(slot.get());
+        }
+    }
+    
+    for (;;) {
+        applyLoadedSamples();
+        const bool ready = std::all_of(wanted.begin(), wanted.end(), [](const LoadSlot* slot) {
+            const int state = slot->state.load(std::memory_order_acquire);
+            return state == LoadApplied || state == LoadFailed;
+        });
+        if (ready) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void SampleManager::finishLoading() {
+    if (!loading) return;
+    
+    for (auto& thread : loadThreads) {
+        thread.join();
+    }
+    loadThreads.clear();
+    applyLoadedSamples();
+    endLoading();
+    
+    // 오디오가 멈춰 있으므로 실패한 항목을 지우고 슬롯도 정리
+    for (const auto& id : loadStats.failed) {
+        samples.erase(id);
+    }
+    loadSlots.clear();
+    
+    setTargetSampleRate(targetSampleRate);  // 로드 중 레이트가 바뀌었으면 변환
+    packSamples();
+}
+
+bool SampleManager::pollLoading() {
+    if (!loading) return false;
+    
+    const int total = static_cast<int>(loadSlots.size());
+    if (numLoadsDone.load(std::memory_order_acquire) < total) return false;
+    
+    const int failed = static_cast<int>(std::count_if(loadSlots.begin(), loadSlots.end(), [](const auto& slot) {
+        return slot->state.load(std::memory_order_relaxed) == LoadFailed;
+    }));
+    if (numLoadsApplied.load(std::memory_order_acquire) + failed < total) return false;
+    
+    for (auto& thread : loadThreads) {
+        thread.join();
+    }
+    loadThreads.clear();
+    endLoading();
+    
+    // 원본 레이트 그대로이거나 (로드 중 디바이스 레이트가 바뀜) 힙에 흩어진 버퍼를 새 아레나로
+    startConversion(targetSampleRate, true);
+    return true;
+}
+
+void SampleManager::endLoading() {
+    double lastMs = loadStartMs;
+    for (const auto& slot : loadSlots) {
+        loadStats.decodeMs += slot->decodeMs;
+        lastMs = juce::jmax(lastMs, slot->finishedMs);
+        if (slot->state.load(std::memory_order_relaxed) == LoadFailed) {
+            loadStats.failed.add(slot->sample->id);
+        }
+    }
+    loadStats.wallMs = lastMs - loadStartMs;
+    loading = false;
+}
+
+void SampleManager::cancelLoading() {
+    cancelLoad.store(true, std::memory_order_relaxed);
+    for (auto& thread : loadThreads) {
+        thread.join();
+    }
+    loadThreads.clear();
+    cancelLoad.store(false, std::memory_order_relaxed);
+    
+    // 오디오 정지 상태에서만 호출되므로 슬롯을 지워도 됨
+    loadSlots.clear();
+    nextLoadSlot.store(0, std::memory_order_relaxed);
+    numLoadsDone.store(0, std::memory_order_relaxed);
+    numLoadsApplied.store(0, std::memory_order_relaxed);
+    loadsSeen = 0;
+    loading = false;
+}
+
+bool SampleManager::loadBank(const juce::File& file, uint64_t sourceHash) {
+    if (!file.existsAsFile()) {
+        return false;
+    }
+    
+    auto mapped = std::make_unique<SampleArena>();
+    if (!mapped->mapFile(file)) {
+        return false;
+    }
+    
+    // 해시 검사가 파일 전체를 읽으므로 페이지도 이때 모두 올라옴
+    juce::String error;
+    if (!SampleBank::validate(mapped->getData(), mapped->getSize(), error)) {
+        juce::Logger::writeToLog("Ignoring sample bank " + file.getFullPathName() + ": " + error);
+        return false;
+    }
+    
+    SampleBank::Header header;
+    std::memcpy(&header, mapped->getData(), sizeof(header));
+    if (targetSampleRate > 0.0 && std::abs(header.sampleRate - targetSampleRate) >= 0.5) {
+        juce::Logger::writeToLog("Sample bank " + file.getFileName() + " is for " + juce::String(header.sampleRate, 0) +
+                                 " Hz, device runs at " + juce::String(targetSampleRate, 0) + " Hz");
+        return false;
+    }
+    if (header.sourceHash != sourceHash) {
+        juce::Logger::writeToLog("Sample bank " + file.getFileName() + " is stale (samples changed since it was compiled)");
+        return false;
+    }
+    
+    finishConversion();
+    samples.clear();
+    streamer.clearSources();
+    size_t streamedBytes = 0;
+    for (uint32_t i = 0; i < header.numSamples; ++i) {
+        SampleBank::IndexEntry entry;
+        std::memcpy(&entry, mapped->getData() + header.indexOffset + i * sizeof(entry), sizeof(entry));
+        
+        auto sample = std::make_unique<Sample>();
+        sample->id = juce::String::fromUTF8(entry.name);
+        sample->sampleRate = header.sampleRate;
+        sample->sourceSampleRate = entry.sourceSampleRate;
+        sample->gain = entry.gain;
+        
+        // 매핑은 읽기 전용 (AudioBuffer가 비const 포인터를 받을 뿐 쓰지 않음)
+        float* channels[SampleBank::MAX_CHANNELS];
+        const size_t stride = SampleArena::channelBytes(static_cast<int>(entry.numFrames));
+        for (uint32_t ch = 0; ch < entry.numChannels; ++ch) {
+            channels[ch] = reinterpret_cast<float*>(const_cast<char*>(mapped->getData()) + entry.dataOffset + ch * stride);
+        }
+        int numFrames = static_cast<int>(entry.numFrames);
+        
+        // 스트리밍: tail은 매핑에서 바로 읽지 않고 I/O 스레드가 파일에서 읽으므로 페이지를 반납
+        const int headFrames = streamHeadFrames(sample->id, static_cast<int>(entry.numChannels), numFrames, header.sampleRate);
+        if (headFrames > 0) {
+            sample->stream = streamer.addFileSource(file, static_cast<int>(entry.numChannels), numFrames, headFrames,
+                                                    static_cast<int64_t>(entry.dataOffset), static_cast<int64_t>(stride));
+        }
+        if (sample->stream != nullptr) {
+            const size_t tailBytes = static_cast<size_t>(numFrames - headFrames) * sizeof(float);
+            for (uint32_t ch = 0; ch < entry.numChannels; ++ch) {
+                mapped->discard(channels[ch] + headFrames, tailBytes);
+            }
+            streamedBytes += tailBytes * entry.numChannels;
+            numFrames = headFrames;
+        }
+        sample->buffer.setDataToReferTo(channels, static_cast<int>(entry.numChannels), numFrames);
+        samples[sample->id] = std::move(sample);
+    }
+    arena = std::move(mapped);
+    
+    juce::Logger::writeToLog("Mapped " + juce::String(getNumSamples()) + " samples from " + file.getFileName() + " (" +
+                             juce::String(static_cast<double>(arena->getSize() - streamedBytes) / (1024.0 * 1024.0), 1) + " MB" +
+                             (arena->isLocked() ? ", locked" : ", not locked") +
+                             (streamedBytes > 0 ? ", " + juce::String(static_cast<double>(streamedBytes) / (1024.0 * 1024.0), 1) +
+                                                  " MB streamed)" : juce::String(")")));
+    return true;
+}
+
+bool SampleManager::writeBank(const juce::File& file, uint64_t sourceHash, juce::String& error) const {
+    // 뱅크는 float PCM이므로 int16으로 담긴 샘플은 펼친 복사본으로 기록
+    std::vector<Sample> expanded;
+    expanded.reserve(samples.size());
+    std::vector<const Sample*> list;
+    for (const auto& [id, sample] : samples) {
+        if (sample->stream != nullptr) {
+            error = "sample '" + id + "' is streamed from disk (disable streaming to compile a bank)";
+            return false;
+        }
+        if (sample->isCompact()) {
+            expanded.push_back(*sample);
+            expandCompact(sample->compact, expanded.back().buffer);
+            expanded.back().compact = {};
+            list.push_back(&expanded.back());
+        } else {
+            list.push_back(sample.get());
+        }
+    }
+    const double rate = targetSampleRate > 0.0 ? targetSampleRate
+                                               : (list.empty() ? 48000.0 : list.front()->sampleRate);
+    return SampleBank::write(file, list, rate, sourceHash, error);
+}
+
+bool SampleManager::packSamples() {
+    finishConversion();
+    if (samples.empty()) {
+        arena.reset();
+        return true;
+    }
+    
+    size_t bytes = 0;
+    std::vector<uint8_t> compact;
+    for (const auto& [id, sample] : samples) {
+        compact.push_back(storesCompact(*sample) && (sample->isCompact() || fitsInt16(sample->buffer)));
+        bytes += arenaBytes(sample->getNumChannels(), sample->getNumFrames(), compact.back());
+    }
+    
+    auto packed = std::make_unique<SampleArena>();
+    if (!packed->allocate(bytes, useHugePages)) {
+        juce::Logger::writeToLog("Warning: sample arena allocation failed, samples stay in separate buffers");
+        return false;
+    }
+    
+    // 이전 아레나를 가리키던 뷰도 새 아레나로 옮긴 뒤 이전 아레나 해제
+    size_t index = 0;
+    for (auto& [id, sample] : samples) {
+        packToArena(*packed, sample->buffer, sample->compact, compact[index++], sample->buffer, sample->compact);
+    }
+    arena = std::move(packed);
+    
+    const int numCompact = getNumCompactSamples();
+    juce::Logger::writeToLog("Packed " + juce::String(getNumSamples()) + " samples into a " +
+                             juce::String(static_cast<double>(arena->getSize()) / (1024.0 * 1024.0), 1) + " MB arena" +
+                             (numCompact > 0 ? " (" + juce::String(numCompact) + " as int16)" : juce::String()) +
+                             (arena->isLocked() ? ", locked" : ", not locked") +
+                             (arena->usesHugePages() ? ", huge pages" : ""));
+    return true;
+}
+
+bool SampleManager::setStreaming(double thresholdMs, double headMs, int numVoices, const juce::File& spillFile) {
+    streamThresholdMs = juce::jmax(0.0, thresholdMs);
+    streamHeadMs = juce::jmax(50.0, headMs);
+    
+    const bool wanted = streamThresholdMs > 0.0 ||
+                        std::any_of(streamThresholds.begin(), streamThresholds.end(),
+                                    [](const auto& entry) { return entry.second > 0.0; });
+    if (!wanted || numVoices <= 0) {
+        streamer.stop();
+        return false;
+    }
+    
+    // 링은 head 길이 이상 (I/O 스레드가 그만큼 미리 읽어 둠)
+    const double rate = targetSampleRate > 0.0 ? targetSampleRate : 48000.0;
+    const int ringFrames = juce::jmax(32768, static_cast<int>(std::ceil(streamHeadMs * rate / 1000.0)));
+    streamer.prepare(numVoices, ringFrames, spillFile);
+    return true;
+}
+
+int SampleManager::getNumCompactSamples() const {
+    return static_cast<int>(std::count_if(samples.begin(), samples.end(),
+                                          [](const auto& entry) { return entry.second->isCompact(); }));
+}
+
+bool SampleManager::storesCompact(const Sample& sample) const {
+    // 24비트/float 원본은 int16으로 줄이면 해상도를 잃으므로 float 그대로
+    return sampleFormat == SampleFormat::Int16 && sample.stream == nullptr && sample.sourceBits > 0 &&
+           sample.sourceBits <= 16 && sample.getNumChannels() <= 2;
+}
+
+int SampleManager::getNumStreamedSamples() const {
+    return static_cast<int>(std::count_if(samples.begin(), samples.end(),
+                                          [](const auto& entry) { return entry.second->stream != nullptr; }));
+}
+
+size_t SampleManager::getStreamedBytes() const {
+    size_t bytes = 0;
+    for (const auto& [id, sample] : samples) {
+        if (const auto* stream = sample->stream) {
+            bytes += static_cast<size_t>(stream->numFrames - stream->headFrames) * sizeof(float) *
+                     static_cast<size_t>(stream->numChannels);
+        }
+    }
+    return bytes;
+}
+
+int SampleManager::streamHeadFrames(const juce::String& id, int numChannels, int numFrames, double sampleRate) const {
+    if (!streamer.isEnabled() || numChannels > SampleStreamer::MAX_CHANNELS || sampleRate <= 0.0) {
+        return 0;
+    }
+    
+    auto it = streamThresholds.find(id);
+    const double thresholdMs = it != streamThresholds.end() ? it->second : streamThresholdMs;
+    if (thresholdMs <= 0.0 || numFrames * 1000.0 / sampleRate <= thresholdMs) {
+        return 0;
+    }
+    
+    const int headFrames = static_cast<int>(std::ceil(streamHeadMs * sampleRate / 1000.0));
+    return headFrames < numFrames ? headFrames : 0;
+}
+
+const SampleStreamer::Source* SampleManager::splitTail(const juce::String& id, juce::AudioBuffer<float>& buffer,
+                                                       double sampleRate) {
+    const int headFrames = streamHeadFrames(id, buffer.getNumChannels(), buffer.getNumSamples(), sampleRate);
+    if (headFrames <= 0) return nullptr;
+    
+    const auto* source = streamer.addTail(buffer, headFrames);
+    if (source == nullptr) return nullptr;
+    
+    // head만 새 버퍼로 남기고 전체 버퍼는 해제
+    juce::AudioBuffer<float> head(buffer.getNumChannels(), headFrames);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch) {
+        head.copyFrom(ch, 0, buffer, ch, 0, headFrames);
+    }
+    buffer = std::move(head);
+    return source;
+}
+
+bool SampleManager::resampleToTarget(Sample& sample) {
+    // 스트리밍 샘플의 tail은 파일에 있으므로 로드 때 레이트 그대로 (비율로 보간 재생)
+    if (sample.stream != nullptr || targetSampleRate <= 0.0 || std::abs(sample.sampleRate - targetSampleRate) < 0.5) {
+        return false;
+    }
+    
+    // int16으로 담긴 샘플은 펼쳐서 변환 (결과는 힙의 float, 다음 packSamples()에서 다시 int16)
+    juce::AudioBuffer<float> widened;
+    if (sample.isCompact()) {
+        expandCompact(sample.compact, widened);
+    }
+    
+    Resampler resampler(sample.sampleRate, targetSampleRate);
+    juce::AudioBuffer<float> resampled;
+    resampler.process(sample.isCompact() ? widened : sample.buffer, resampled);
+    sample.buffer = std::move(resampled);
+    sample.compact = {};
+    sample.sampleRate = targetSampleRate;
+    return true;
+}
+
+void SampleManager::setTargetSampleRate(double sampleRate) {
+    finishConversion();
+    targetSampleRate = juce::jmax(0.0, sampleRate);
+    if (loading) {
+        // 아직 디코딩 중인 파일은 새 레이트로, 이미 끝난 샘플은 로드 마무리 때 변환
+        loadRate.store(targetSampleRate, std::memory_order_relaxed);
+        return;
+    }
+    
+    int numConverted = 0;
+    for (auto& [id, sample] : samples) {
+        if (resampleToTarget(*sample)) ++numConverted;
+    }
+    if (numConverted > 0) {
+        juce::Logger::writeToLog("Resampled " + juce::String(numConverted) + " samples to " +
+                                 juce::String(targetSampleRate, 0) + " Hz");
+        if (arena != nullptr) {
+            packSamples();  // 변환된 버퍼는 힙에 있으므로 다시 모음
+        }
+    }
+}
+
+void SampleManager::convertInBackground(double sampleRate) {
+    if (loading) {
+        setTargetSampleRate(sampleRate);  // pollLoading()이 마무리하며 변환
+        return;
+    }
+    startConversion(sampleRate, false);
+}
+
+void SampleManager::startConversion(double sampleRate, bool pack) {
+    finishConversion();
+    targetSampleRate = juce::jmax(0.0, sampleRate);
+    if (targetSampleRate <= 0.0 && !pack) return;
+    
+    const bool repack = arena != nullptr || pack;
+    int numToConvert = 0;
+    for (auto& [id, sample] : samples) {
+        if (!sample->isValid()) continue;  // 로드 실패
+        if (sample->stream == nullptr && targetSampleRate > 0.0 &&
+            std::abs(sample->sampleRate - targetSampleRate) >= 0.5) {
+            ++numToConvert;
+            converted.push_back({ sample.get(), {}, {}, true, false });
+        } else if (repack) {
+            converted.push_back({ sample.get(), {}, {}, false, false });  // 새 아레나로 복사만
+        }
+    }
+    if (numToConvert == 0 && !pack) {
+        converted.clear();
+        return;
+    }
+    if (converted.empty()) return;
+    
+    // 변환 중에도 오디오 스레드는 기존 버퍼를 읽기만 하므로 공유 가능
+    convertedRate = targetSampleRate;
+    conversionState.store(ConversionRunning, std::memory_order_relaxed);
+    conversionThread = std::thread([this, numToConvert, repack] {
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+        size_t bytes = 0;
+        for (auto& entry : converted) {
+            if (cancelConversion.load(std::memory_order_relaxed)) return;
+            const Sample& sample = *entry.sample;
+            if (entry.resample) {
+                Resampler resampler(sample.sampleRate, convertedRate);
+                if (sample.isCompact()) {
+                    juce::AudioBuffer<float> widened;
+                    expandCompact(sample.compact, widened);
+                    resampler.process(widened, entry.buffer);
+                } else {
+                    resampler.process(sample.buffer, entry.buffer);
+                }
+                entry.packCompact = storesCompact(sample) && fitsInt16(entry.buffer);
+                bytes += arenaBytes(entry.buffer.getNumChannels(), entry.buffer.getNumSamples(), entry.packCompact);
+            } else {
+                entry.packCompact = storesCompact(sample) && (sample.isCompact() || fitsInt16(sample.buffer));
+                bytes += arenaBytes(sample.getNumChannels(), sample.getNumFrames(), entry.packCompact);
+            }
+        }
+        
+        // 변환 결과와 그대로인 샘플을 새 아레나 하나로 (실패하면 변환 결과만 힙 버퍼로 교체)
+        if (repack) {
+            auto packed = std::make_unique<SampleArena>();
+            if (packed->allocate(bytes, useHugePages)) {
+                for (auto& entry : converted) {
+                    const Sample& sample = *entry.sample;
+                    if (entry.resample) {
+                        packToArena(*packed, entry.buffer, {}, entry.packCompact, entry.buffer, entry.compact);
+                    } else {
+                        packToArena(*packed, sample.buffer, sample.compact, entry.packCompact, entry.buffer,
+                                    entry.compact);
+                    }
+                }
+                pendingArena = std::move(packed);
+            }
+        }
+        
+        const juce::String elapsed = juce::String(juce::Time::getMillisecondCounterHiRes() - startMs, 1) + " ms";
+        if (numToConvert > 0) {
+            juce::Logger::writeToLog("Resampled " + juce::String(numToConvert) + " samples to " +
+                                     juce::String(convertedRate, 0) + " Hz in background (" + elapsed + ")");
+        }
+        if (pendingArena != nullptr) {
+            juce::Logger::writeToLog("Packed " + juce::String(static_cast<int>(converted.size())) + " samples into a " +
+                                     juce::String(static_cast<double>(pendingArena->getSize()) / (1024.0 * 1024.0), 1) +
+                                     " MB arena in background (" + elapsed + ")" +
+                                     (pendingArena->isLocked() ? "" : ", not locked"));
+        }
+        conversionState.store(ConversionReady, std::memory_order_release);
+    });
+}
+
+bool SampleManager::applyConvertedSamples(SamplePlayer& player) {
+    if (conversionState.load(std::memory_order_relaxed) != ConversionReady) return false;
+    
+    int expected = ConversionReady;
+    if (!conversionState.compare_exchange_strong(expected, ConversionApplying, std::memory_order_acquire)) {
+        return false;
+    }
+    
+    // 버퍼 교환은 이동만 (할당/해제 없음), 이전 버퍼와 아레나는 converted/pendingArena에 남아
+    // 나중에 메인 스레드가 해제
+    for (auto& entry : converted) {
+        if (entry.buffer.getNumSamples() == 0 && entry.compact.numFrames == 0) continue;
+        Sample* sample = entry.sample;
+        std::swap(sample->buffer, entry.buffer);
+        std::swap(sample->compact, entry.compact);
+        if (entry.resample) {
+            const double ratio = convertedRate / sample->sampleRate;
+            sample->sampleRate = convertedRate;
+            if (! juce::exactlyEqual(ratio, 1.0)) {
+                player.rescaleVoices(sample, ratio);
+            }
+        }
+    }
+    if (pendingArena != nullptr) {
+        std::swap(arena, pendingArena);
+    }
+    
+    conversionState.store(ConversionIdle, std::memory_order_release);
+    return true;
+}
+
+void SampleManager::finishConversion() {
+    cancelConversion.store(true, std::memory_order_relaxed);
+    if (conversionThread.joinable()) {
+        conversionThread.join();
+    }
+    cancelConversion.store(false, std::memory_order_relaxed);
+    
+    // 아직 교체되지 않은 결과는 버리고, 교체 중이면 끝날 때까지 대기
+    int expected = ConversionReady;
+    conversionState.compare_exchange_strong(expected, ConversionIdle, std::memory_order_acquire);
+    while (conversionState.load(std::memory_order_acquire) == ConversionApplying) {
+        std::this_thread::yield();
+    }
+    conversionState.store(ConversionIdle, std::memory_order_relaxed);
+    converted.clear();
+    pendingArena.reset();
 }
 
 juce::StringArray SampleManager::getAllSampleIds() const {
@@ -68,100 +787,373 @@ juce::StringArray SampleManager::getAllSampleIds() const {
     return ids;
 }
 
-void SampleManager::setSampleGain(const juce::String& id, float gain) {
-    sampleGains[id] = gain;
+bool SampleManager::setSampleGain(const juce::String& id, float gain) {
+    auto it = samples.find(id);
+    if (it == samples.end()) {
+        return false;
+    }
+    it->second->gain = juce::jmax(0.0f, gain);
+    return true;
 }
 
 float SampleManager::getSampleGain(const juce::String& id) const {
-    auto it = sampleGains.find(id);
-    if (it != sampleGains.end()) {
-        return it->second;
+    auto it = samples.find(id);
+    if (it != samples.end()) {
+        return it->second->gain;
     }
     return 1.0f;
 }
 
-// SampleVoice 구현
+bool SampleManager::setSampleMaxVoices(const juce::String& id, int maxVoices) {
+    auto it = samples.find(id);
+    if (it == samples.end()) {
+        return false;
+    }
+    it->second->maxVoices = juce::jmax(0, maxVoices);
+    return true;
+}
+
+bool SampleManager::setSamplePitchRandom(const juce::String& id, float semitones) {
+    auto it = samples.find(id);
+    if (it == samples.end()) {
+        return false;
+    }
+    it->second->pitchRandom = juce::jlimit(0.0f, 12.0f, semitones);
+    return true;
+}
 
-void SampleVoice::trigger(const Sample* sample, float velocity) {
-    if (sample == nullptr || !sample->isValid()) return;
-    
-    currentSample = sample;
-    position = 0.0;
-    gain = velocity;
-    isPlaying = true;
+// SamplePlayer 구현
+
+SamplePlayer::SamplePlayer(int maxVoices) {
+    setNumVoices(maxVoices);
 }
 
-void SampleVoice::stop() {
-    isPlaying = false;
-    currentSample = nullptr;
+SamplePlayer::~SamplePlayer() {
+    for (size_t v = 0; v < voiceStream.size(); ++v) {
+        releaseStream(static_cast<int>(v));
+    }
 }
 
-void SampleVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, 
-                                   int startSample, int numSamples) {
-    if (!isPlaying || currentSample == nullptr) return;
+void SamplePlayer::setNumVoices(int maxVoices) {
+    for (size_t v = 0; v < voiceStream.size(); ++v) {
+        releaseStream(static_cast<int>(v));
+    }
+    maxPlaying = juce::jlimit(1, MAX_VOICES - STEAL_RESERVE, maxVoices);
+    const auto total = static_cast<size_t>(maxPlaying + STEAL_RESERVE);
     
-    const auto& sourceBuffer = currentSample->buffer;
-    int sourceChannels = sourceBuffer.getNumChannels();
-    int outputChannels = outputBuffer.getNumChannels();
-    int sourceSamples = sourceBuffer.getNumSamples();
+    voiceSample.assign(total, nullptr);
+    voicePosition.assign(total, 0.0);
+    voiceRate.assign(total, 1.0f);
+    voiceGain.assign(total, 0.0f);
+    voiceStartDelay.assign(total, 0);
+    voiceFade.assign(total, 1.0f);
+    voiceFadeStep.assign(total, 0.0f);
+    voiceLevel.assign(total, 0.0f);
+    voiceOrder.assign(total, 0);
+    voiceDone.assign(total, 0);
+    voiceStream.assign(total, -1);
     
-    for (int i = 0; i < numSamples; ++i) {
-        int pos = static_cast<int>(position);
-        if (pos >= sourceSamples) {
-            isPlaying = false;
-            break;
+    // 낮은 번호부터 꺼내도록 역순으로 채움
+    freeVoices.resize(total);
+    for (size_t i = 0; i < total; ++i) {
+        freeVoices[i] = static_cast<uint16_t>(total - 1 - i);
+    }
+    numFree = static_cast<int>(total);
+    activeVoices.assign(total, 0);
+    numActive = 0;
+    numFading = 0;
+}
+
+void SamplePlayer::setRenderPool(VoiceRenderPool* pool, int minVoices) {
+    renderPool = pool;
+    parallelMinVoices = juce::jmax(2, minVoices);
+}
+
+void SamplePlayer::rescaleVoices(const Sample* sample, double ratio) {
+    for (int i = 0; i < numActive; ++i) {
+        const int v = activeVoices[i];
+        if (voiceSample[v] == sample) {
+            voicePosition[v] *= ratio;
         }
-        
-        // 간단한 선형 보간
-        float frac = static_cast<float>(position - pos);
-        int nextPos = juce::jmin(pos + 1, sourceSamples - 1);
-        
-        for (int ch = 0; ch < outputChannels; ++ch) {
-            int srcCh = juce::jmin(ch, sourceChannels - 1);
-            const float* srcData = sourceBuffer.getReadPointer(srcCh);
-            float* outData = outputBuffer.getWritePointer(ch);
+    }
+}
+
+void SamplePlayer::trigger(const Sample* sample, float velocity, int startOffset, float rate) {
+    if (sample == nullptr || !sample->isValid()) return;
+    
+    const int cap = sample->maxVoices > 0 ? sample->maxVoices : defaultVoicesPerSample;
+    const int playing = numActive - numFading;
+    
+    if (cap > 0 || playing >= maxPlaying) {
+        // 한 번 훑어서 같은 샘플의 보이스 수/가장 오래된 보이스, 전체에서 가장 조용한 보이스를 찾음
+        int sameCount = 0;
+        int oldestSame = -1;
+        int quietest = -1;
+        for (int i = 0; i < numActive; ++i) {
+            const int v = activeVoices[i];
+            if (voiceFadeStep[v] > 0.0f) continue;  // 이미 페이드 아웃 중
             
-            float sample = srcData[pos] * (1.0f - frac) + srcData[nextPos] * frac;
-            outData[startSample + i] += sample * gain;
+            if (voiceSample[v] == sample) {
+                ++sameCount;
+                if (oldestSame < 0 || voiceOrder[v] < voiceOrder[oldestSame]) {
+                    oldestSame = v;
+                }
+            }
+            if (quietest < 0 || voiceLevel[v] < voiceLevel[quietest] ||
+                (juce::exactlyEqual(voiceLevel[v], voiceLevel[quietest]) &&
+                 voiceOrder[v] < voiceOrder[quietest])) {
+                quietest = v;
+            }
         }
         
-        position += 1.0; // 샘플레이트 변환은 나중에 추가 가능
+        if (cap > 0 && sameCount >= cap) {
+            startFadeOut(oldestSame);
+            cappedVoices.store(cappedVoices.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        } else if (playing >= maxPlaying && quietest >= 0) {
+            startFadeOut(quietest);
+            stolenVoices.store(stolenVoices.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+    
+    const int v = allocateVoice();
+    if (v < 0) return;
+    
+    voiceSample[v] = sample;
+    voicePosition[v] = 0.0;
+    voiceRate[v] = rate > 0.0f ? rate : 1.0f;
+    voiceGain[v] = velocity * sample->gain;
+    voiceStartDelay[v] = juce::jmax(0, startOffset);
+    voiceFade[v] = 1.0f;
+    voiceFadeStep[v] = 0.0f;
+    voiceLevel[v] = voiceGain[v];  // 렌더링 전까지는 크게 가정 (방금 시작한 보이스를 교체하지 않도록)
+    voiceOrder[v] = nextOrder++;
+    voiceDone[v] = 0;
+    
+    // 재사용한 보이스가 쥐고 있던 슬롯은 반납 (빈 슬롯이 없으면 head만 재생)
+    releaseStream(v);
+    if (sample->stream != nullptr && streamer != nullptr && streamer->isEnabled()) {
+        voiceStream[v] = streamer->acquire(sample->stream);
     }
 }
 
-// SamplePlayer 구현
+void SamplePlayer::releaseStream(int v) {
+    if (voiceStream[v] >= 0) {
+        streamer->release(voiceStream[v]);
+        voiceStream[v] = -1;
+    }
+}
 
-SamplePlayer::SamplePlayer(int maxVoices) {
-    voices.reserve(maxVoices);
-    for (int i = 0; i < maxVoices; ++i) {
-        voices.push_back(std::make_unique<SampleVoice>());
+int SamplePlayer::allocateVoice() {
+    if (numFree > 0) {
+        const int voice = freeVoices[--numFree];
+        activeVoices[numActive++] = static_cast<uint16_t>(voice);
+        return voice;
+    }
+    
+    // 예비 보이스까지 모두 페이드 아웃 중: 가장 많이 줄어든 보이스를 바로 재사용 (활성 목록에 그대로 둠)
+    int best = -1;
+    for (int i = 0; i < numActive; ++i) {
+        const int v = activeVoices[i];
+        if (voiceFadeStep[v] > 0.0f &&
+            (best < 0 || voiceFade[v] < voiceFade[best])) {
+            best = v;
+        }
+    }
+    if (best >= 0) {
+        --numFading;
     }
+    return best;
 }
 
-void SamplePlayer::trigger(const Sample* sample, float velocity) {
-    int voiceIndex = findFreeVoice();
-    if (voiceIndex >= 0) {
-        voices[voiceIndex]->trigger(sample, velocity);
+void SamplePlayer::startFadeOut(int v) {
+    if (voiceFadeStep[v] > 0.0f) return;
+    
+    voiceFadeStep[v] = 1.0f / static_cast<float>(STEAL_FADE_SAMPLES);
+    if (voiceStartDelay[v] > 0) {
+        voiceFade[v] = 0.0f;  // 아직 소리가 나지 않았으면 바로 끝냄
     }
+    ++numFading;
 }
 
-void SamplePlayer::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, 
-                                    int startSample, int numSamples) {
-    for (auto& voice : voices) {
-        if (voice->isActive()) {
-            voice->renderNextBlock(outputBuffer, startSample, numSamples);
+void SamplePlayer::renderVoice(int v, juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) {
+    const Sample* sample = voiceSample[v];
+    float fade = voiceFade[v];
+    const float fadeStep = voiceFadeStep[v];
+    
+    if (sample == nullptr || fade <= 0.0f) {
+        voiceDone[v] = 1;
+        return;
+    }
+    
+    // 블록 중간 시작 (샘플 단위 트리거)
+    int startDelay = voiceStartDelay[v];
+    if (startDelay > 0) {
+        if (startDelay >= numSamples) {
+            voiceStartDelay[v] = startDelay - numSamples;
+            return;
+        }
+        startSample += startDelay;
+        numSamples -= startDelay;
+        voiceStartDelay[v] = 0;
+    }
+    
+    const auto& sourceBuffer = sample->buffer;
+    const int sourceChannels = sample->getNumChannels();
+    const int outputChannels = outputBuffer.getNumChannels();
+    const bool streamed = voiceStream[v] >= 0;
+    const int sourceSamples = streamed ? sample->stream->numFrames : sample->getNumFrames();
+    const double startPosition = voicePosition[v];
+    
+    // 샘플은 로드 시 출력 레이트로 변환되므로 보통 재생 속도 그대로 (백그라운드 재변환 대기 중에만 비율 포함)
+    const double step = voiceRate[v] * (sample->sampleRate / outputSampleRate);
+    
+    // 이번 블록에 렌더링할 프레임 수 (샘플 끝 또는 페이드 끝에서 멈춤)
+    int frames = juce::jlimit(0, numSamples, static_cast<int>(std::ceil((sourceSamples - startPosition) / step)));
+    if (fadeStep > 0.0f) {
+        frames = juce::jmin(frames, static_cast<int>(std::ceil(fade / fadeStep)));
+    }
+    
+    // 교체 페이드는 블록 안에서 선형으로 줄어드는 게인으로 처리
+    const float gain = voiceGain[v] * fade;
+    const float gainStep = -voiceGain[v] * fadeStep;
+    const int channels = juce::jmin(outputChannels, MAX_RENDER_CHANNELS);
+    const int startIndex = static_cast<int>(startPosition);
+    const bool unitStep = juce::exactlyEqual(step, 1.0) && juce::exactlyEqual(startPosition, static_cast<double>(startIndex));
+    
+    float* outPtrs[MAX_RENDER_CHANNELS];
+    const float* srcPtrs[MAX_RENDER_CHANNELS];
+    const int srcChannels = juce::jmin(sourceChannels, channels);
+    for (int ch = 0; ch < channels; ++ch) {
+        outPtrs[ch] = outputBuffer.getWritePointer(ch, startSample);
+    }
+    
+    float peak;
+    if (streamed) {
+        peak = renderStreamed(v, outPtrs, channels, srcChannels, startPosition, step, frames, gain, gainStep);
+    } else if (sample->isCompact()) {
+        // int16 PCM: 커널이 로드하며 float로 변환하고 1/32768은 게인에 합침
+        const int16_t* compactPtrs[2];
+        for (int ch = 0; ch < srcChannels; ++ch) {
+            compactPtrs[ch] = sample->compact.channels[ch] + (unitStep ? startIndex : 0);
+        }
+        peak = unitStep ? RenderKernels::mixUnitStep(outPtrs, channels, compactPtrs, srcChannels, frames, gain, gainStep)
+                        : RenderKernels::mixResampled(interpolation, outPtrs, channels, compactPtrs, srcChannels,
+                                                      sourceSamples, startPosition, step, frames, gain, gainStep);
+    } else if (unitStep) {
+        // 정수 스텝: 보간 없이 SIMD 게인-누적
+        for (int ch = 0; ch < srcChannels; ++ch) {
+            srcPtrs[ch] = sourceBuffer.getReadPointer(ch, startIndex);
+        }
+        peak = RenderKernels::mixUnitStep(outPtrs, channels, srcPtrs, srcChannels, frames, gain, gainStep);
+    } else {
+        for (int ch = 0; ch < srcChannels; ++ch) {
+            srcPtrs[ch] = sourceBuffer.getReadPointer(ch);
+        }
+        peak = RenderKernels::mixResampled(interpolation, outPtrs, channels, srcPtrs, srcChannels, sourceSamples,
+                                           startPosition, step, frames, gain, gainStep);
+    }
+    
+    voicePosition[v] = startPosition + frames * step;
+    fade = juce::jmax(0.0f, fade - fadeStep * static_cast<float>(frames));
+    voiceFade[v] = fade;
+    voiceLevel[v] = peak;
+    
+    if (frames < numSamples || fade <= 0.0f || static_cast<int>(voicePosition[v]) >= sourceSamples) {
+        voiceDone[v] = 1;
+    }
+}
+
+float SamplePlayer::renderStreamed(int v, float* const* out, int channels, int srcChannels, double position,
+                                   double step, int frames, float gain, float gainStep) {
+    const Sample* sample = voiceSample[v];
+    const auto& source = *sample->stream;
+    const int slot = voiceStream[v];
+    
+    // 한 조각이 지나가는 소스 구간이 스트리머의 창 버퍼에 들어가도록 나눠 렌더링
+    const int chunkFrames = juce::jmax(1, static_cast<int>(SampleStreamer::WINDOW_FRAMES / step));
+    float* outPtrs[MAX_RENDER_CHANNELS];
+    for (int ch = 0; ch < channels; ++ch) {
+        outPtrs[ch] = out[ch];
+    }
+    
+    float peak = 0.0f;
+    for (int done = 0; done < frames; ) {
+        const int n = juce::jmin(chunkFrames, frames - done);
+        const int64_t index = static_cast<int64_t>(position);
+        const int64_t first = juce::jmax<int64_t>(0, index - SampleStreamer::HISTORY);
+        const int64_t last = juce::jmin<int64_t>(source.numFrames,
+                                                 static_cast<int64_t>(position + n * step) + SampleStreamer::LOOKAHEAD + 1);
+        
+        // head 안이면 상주 버퍼를 그대로, 아니면 head/링에서 창으로 모음
+        const float* srcPtrs[MAX_RENDER_CHANNELS];
+        int64_t windowStart = 0;
+        int windowLength = source.headFrames;
+        if (last <= source.headFrames) {
+            for (int ch = 0; ch < srcChannels; ++ch) {
+                srcPtrs[ch] = sample->buffer.getReadPointer(ch);
+            }
+        } else {
+            const float* window[SampleStreamer::MAX_CHANNELS];
+            windowStart = first;
+            windowLength = static_cast<int>(last - first);
+            streamer->read(slot, sample->buffer, first, windowLength, window);
+            for (int ch = 0; ch < srcChannels; ++ch) {
+                srcPtrs[ch] = window[ch];
+            }
+        }
+        
+        const double local = position - static_cast<double>(windowStart);
+        const int localIndex = static_cast<int>(local);
+        float chunkPeak;
+        if (juce::exactlyEqual(step, 1.0) && juce::exactlyEqual(local, static_cast<double>(localIndex))) {
+            for (int ch = 0; ch < srcChannels; ++ch) {
+                srcPtrs[ch] += localIndex;
+            }
+            chunkPeak = RenderKernels::mixUnitStep(outPtrs, channels, srcPtrs, srcChannels, n, gain, gainStep);
+        } else {
+            chunkPeak = RenderKernels::mixResampled(interpolation, outPtrs, channels, srcPtrs, srcChannels, windowLength,
+                                                    local, step, n, gain, gainStep);
+        }
+        
+        peak = juce::jmax(peak, chunkPeak);
+        position += n * step;
+        gain += gainStep * static_cast<float>(n);
+        for (int ch = 0; ch < channels; ++ch) {
+            outPtrs[ch] += n;
         }
+        done += n;
     }
+    
+    streamer->consumed(slot, juce::jmax<int64_t>(0, static_cast<int64_t>(position) - SampleStreamer::HISTORY));
+    return peak;
 }
 
-int SamplePlayer::findFreeVoice() {
-    for (size_t i = 0; i < voices.size(); ++i) {
-        if (!voices[i]->isActive()) {
-            return static_cast<int>(i);
+void SamplePlayer::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, 
+                                    int startSample, int numSamples) {
+    if (numActive == 0) return;
+    
+    if (renderPool != nullptr && numActive >= parallelMinVoices &&
+        renderPool->canRender(outputBuffer.getNumChannels(), startSample, numSamples)) {
+        renderPool->render(*this, activeVoices.data(), numActive, outputBuffer, startSample, numSamples);
+    } else {
+        for (int i = 0; i < numActive; ++i) {
+            renderVoice(activeVoices[i], outputBuffer, startSample, numSamples);
+        }
+    }
+    
+    // 끝난 보이스 회수 (마지막 항목과 바꿔 제거)
+    for (int i = 0; i < numActive; ) {
+        const int v = activeVoices[i];
+        if (voiceDone[v]) {
+            if (voiceFadeStep[v] > 0.0f) --numFading;
+            releaseStream(v);
+            voiceSample[v] = nullptr;
+            freeVoices[numFree++] = static_cast<uint16_t>(v);
+            activeVoices[i] = activeVoices[--numActive];
+        } else {
+            ++i;
         }
     }
-    // 가장 오래된 보이스 교체 (간단한 보이스 스틸링)
-    return 0;
 }
 
 } // namespace FXBoard
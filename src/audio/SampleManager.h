@@ -1,32 +1,111 @@
 #pragma once
 #include <juce_audio_formats/juce_audio_formats.h>
+#include "RenderKernels.h"
+#include "SampleArena.h"
+#include "SampleStreamer.h"
+#include <atomic>
 #include <map>
 #include <memory>
+#include <thread>
+#include <vector>
 
 namespace FXBoard {
 
+class VoiceRenderPool;
+class SamplePlayer;
+
+/**
+ * 아레나에 int16으로 담은 PCM (값 / 32768 = float 샘플)
+ * 채널마다 끝 뒤에 0인 여유 샘플이 하나 있음 (SIMD gather가 2바이트 간격으로 32비트씩 읽음)
+ */
+struct CompactPcm {
+    const int16_t* channels[2] = {};
+    int numChannels = 0;
+    int numFrames = 0;
+};
+
 /**
  * 샘플 데이터 구조
+ * packSamples()/loadBank() 이후 buffer는 SampleManager의 아레나나 매핑한 뱅크 파일을 가리키는
+ * 읽기 전용 뷰 (데이터를 소유하지 않음)
+ * int16으로 모은 샘플은 buffer가 비어 있고 PCM은 compact에 있음 (SampleFormat::Int16)
+ * 스트리밍 샘플은 buffer에 앞부분(head)만 있고 전체 길이와 나머지 위치는 stream에 있음
  */
 struct Sample {
     juce::String id;
     juce::AudioBuffer<float> buffer;
-    double sampleRate = 48000.0;
+    CompactPcm compact;
+    double sampleRate = 48000.0;        // buffer의 샘플레이트 (변환 후에는 디바이스 레이트)
+    double sourceSampleRate = 48000.0;  // 원본 파일의 샘플레이트
+    float gain = 1.0f;  // 트리거 벨로시티에 곱하는 게인
+    int maxVoices = 0;  // 이 샘플의 최대 동시 보이스 수 (0 = 플레이어 기본값)
+    float pitchRandom = 0.0f;  // 트리거마다 ± 이 범위(반음)에서 무작위 피치 (0 = 없음)
+    const SampleStreamer::Source* stream = nullptr;  // nullptr = 전체 상주
+    int sourceBits = 0;  // 원본 파일의 정수 비트 수 (0 = float 원본이거나 모름)
+    
+    bool isCompact() const { return compact.numFrames > 0; }
+    int getNumChannels() const { return isCompact() ? compact.numChannels : buffer.getNumChannels(); }
+    int getNumFrames() const { return isCompact() ? compact.numFrames : buffer.getNumSamples(); }
     
     bool isValid() const {
-        return buffer.getNumSamples() > 0;
+        return getNumFrames() > 0;
     }
 };
 
+/**
+ * 아레나에 담는 PCM 형식
+ * - Float32: 모두 float
+ * - Int16: 16비트 이하 정수 원본은 int16으로 담고 렌더링 커널이 게인과 함께 float로 변환
+ *   (메모리/캐시 사용량 절반, 24비트/float 원본과 스트리밍 샘플은 float 그대로)
+ */
+enum class SampleFormat { Float32, Int16 };
+
 /**
  * 샘플 관리자
  * WAV/FLAC 파일을 로드하고 메모리에 상주
+ *
+ * 대상 샘플레이트(디바이스 레이트)가 정해져 있으면 로드할 때 Resampler로 변환해 두므로
+ * 재생은 항상 보간 없는 정수 스텝으로 진행
+ * 재생 중 디바이스 레이트가 바뀌면 백그라운드 스레드에서 다시 변환한 뒤
+ * 오디오 스레드가 블록 경계에서 버퍼를 교체 (그 전까지는 레이트 비율로 보간 재생)
+ *
+ * 로드를 마친 뒤 packSamples()로 모든 PCM을 잠긴 연속 영역(SampleArena) 하나에 모음
+ * 백그라운드 변환도 새 아레나를 만들어 통째로 교체
+ *
+ * 샘플 뱅크(.fxbank, SampleBank.h)가 최신이면 WAV 디코딩 대신 loadBank()로 파일을 매핑해 그대로 사용
+ *
+ * loadSamplesAsync()는 여러 워커 스레드에서 파일을 병렬로 디코딩 (디바이스를 여는 동안 진행)
+ * 필요한 샘플만 기다렸다가 오디오를 시작하고 나머지는 오디오 스레드가 블록 시작마다 받아 넣음
+ *
+ * setStreaming()을 켜면 임계 길이보다 긴 샘플은 앞부분만 상주하고 나머지는 SampleStreamer로 재생
+ * (스트리밍 샘플은 로드할 때의 레이트로 고정, 이후 디바이스 레이트가 바뀌면 비율로 보간 재생)
  */
 class SampleManager {
 public:
     SampleManager();
     ~SampleManager();
     
+    /**
+     * 대상 샘플레이트 설정 (오디오 정지 상태에서 호출)
+     * 이미 로드된 샘플은 이 스레드에서 바로 변환, 이후 로드하는 샘플은 로드 시 변환
+     * @param sampleRate 0 = 변환 안 함 (원본 레이트 유지)
+     */
+    void setTargetSampleRate(double sampleRate);
+    double getTargetSampleRate() const { return targetSampleRate; }
+    
+    /**
+     * 재생 중 대상 샘플레이트 변경 (디바이스 재시작 등, 오디오 스레드 밖에서 호출)
+     * 백그라운드 스레드에서 변환하고 완료되면 오디오 스레드의 applyConvertedSamples()가 교체
+     */
+    void convertInBackground(double sampleRate);
+    
+    /**
+     * 백그라운드 변환이 끝났으면 샘플 버퍼를 교체하고 재생 중인 보이스 위치를 새 레이트로 환산
+     * 오디오 스레드에서 블록 시작 시 호출 (할당/해제 없음, 이전 버퍼는 다음 변환이나 clear() 때 해제)
+     * @return 이번 호출에서 교체했으면 true
+     */
+    bool applyConvertedSamples(SamplePlayer& player);
+    
     /**
      * 샘플 로드
      * @param id 샘플 ID (참조용)
@@ -35,6 +114,132 @@ public:
      */
     bool loadSample(const juce::String& id, const juce::File& filePath);
     
+    /**
+     * 여러 파일의 병렬 디코딩 시작 (오디오 정지 상태에서 호출, 바로 반환)
+     * 샘플 항목은 지금 모두 만들어지므로 게인/보이스 설정은 바로 가능 (디코딩 전에는 버퍼가 비어 재생 안 됨)
+     * 디코딩한 버퍼는 applyLoadedSamples()를 호출하는 스레드가 샘플에 넣음
+     * - 오디오 시작 전: waitForSamples()/finishLoading()을 호출한 스레드
+     * - 오디오 시작 후: 오디오 스레드 (블록 시작)
+     * 로드 중 대상 레이트가 바뀌면 이후 디코딩부터 새 레이트로 변환하고 이미 끝난 샘플은 마무리 때 다시 변환
+     * @param files (샘플 ID, 파일) 목록, 중복 ID는 처음 것만
+     * @param numThreads 0 = 하드웨어 스레드 수
+     */
+    void loadSamplesAsync(const std::vector<std::pair<juce::String, juce::File>>& files, int numThreads);
+    
+    /**
+     * 디코딩이 끝난 샘플을 샘플 항목에 넣음 (버퍼 교환만, 할당/해제 없음)
+     * 오디오 스레드 또는 오디오 시작 전의 메인 스레드에서, 한 번에 한 스레드만
+     * @return 이번 호출에서 넣은 샘플 수
+     */
+    int applyLoadedSamples();
+    
+    /**
+     * 주어진 샘플들이 재생 가능해질 때까지 대기 (오디오 시작 전, 직접 applyLoadedSamples() 호출)
+     * 로드 목록에 없는 ID는 무시
+     */
+    void waitForSamples(const juce::StringArray& ids);
+    
+    /**
+     * 남은 디코딩을 모두 기다린 뒤 대상 레이트로 변환하고 packSamples() (오디오 정지 상태에서)
+     * 로드에 실패한 항목은 제거
+     */
+    void finishLoading();
+    
+    /**
+     * 오디오 재생 중 로드 진행 확인 (메인 스레드에서 주기적으로)
+     * 모든 샘플이 디코딩되어 오디오 스레드가 넣었으면 워커를 정리하고
+     * 백그라운드에서 레이트 변환 + 아레나로 모은 뒤 applyConvertedSamples()로 교체
+     * 로드에 실패한 항목은 남지만 재생되지 않음
+     * @return 이번 호출에서 로드가 끝났으면 true
+     */
+    bool pollLoading();
+    
+    bool isLoading() const { return loading; }
+    
+    /**
+     * 마지막 병렬 로드 통계 (로드가 끝난 뒤 조회)
+     */
+    struct LoadStats {
+        int numFiles = 0;
+        int numThreads = 0;
+        double wallMs = 0.0;    // 로드 시작 ~ 마지막 파일 디코딩 끝
+        double decodeMs = 0.0;  // 파일별 디코딩 + 변환 시간의 합
+        juce::StringArray failed;
+    };
+    const LoadStats& getLoadStats() const { return loadStats; }
+    
+    /**
+     * 메모리의 오디오 데이터를 샘플로 등록 (합성 샘플, 벤치마크용)
+     * @return 버퍼가 비어 있으면 false
+     */
+    bool addSample(const juce::String& id, const juce::AudioBuffer<float>& buffer, double sampleRate);
+    
+    /**
+     * 샘플 뱅크를 매핑해 모든 샘플을 교체 (오디오 정지 상태에서)
+     * PCM은 복사하지 않고 매핑한 파일을 직접 가리킴
+     * @param sourceHash 현재 원본 파일로 계산한 SampleBank::hashSources() 값
+     * @return 뱅크가 없거나 손상/낡았거나 레이트가 대상 레이트와 다르면 false (기존 샘플 유지)
+     */
+    bool loadBank(const juce::File& file, uint64_t sourceHash);
+    
+    /**
+     * 현재 샘플 전체를 뱅크 파일로 기록 (모두 대상 레이트로 변환되어 있어야 함, 스트리밍 샘플은 불가)
+     * @return 실패 시 false, error에 이유
+     */
+    bool writeBank(const juce::File& file, uint64_t sourceHash, juce::String& error) const;
+    
+    /**
+     * 로드한 모든 샘플의 PCM을 새 아레나 하나로 옮김 (오디오 정지 상태에서, 로드를 마친 뒤 호출)
+     * 이후 추가한 샘플은 다음 packSamples()까지 각자 힙 버퍼에 둠
+     * @return 아레나를 할당하지 못하면 false (샘플은 기존 버퍼 그대로)
+     */
+    bool packSamples();
+    
+    /**
+     * 아레나에 huge page 사용 (다음 packSamples()부터 적용)
+     */
+    void setHugePages(bool enabled) { useHugePages = enabled; }
+    
+    /**
+     * 아레나에 담을 PCM 형식 (다음 packSamples()부터 적용, 샘플 뱅크로 매핑한 샘플은 항상 float)
+     */
+    void setSampleFormat(SampleFormat format) { sampleFormat = format; }
+    SampleFormat getSampleFormat() const { return sampleFormat; }
+    
+    /**
+     * int16으로 담긴 샘플 수
+     */
+    int getNumCompactSamples() const;
+    
+    /**
+     * 긴 샘플 스트리밍 설정 (오디오 정지 상태에서, 대상 레이트를 정한 뒤 로드 전에 호출)
+     * @param thresholdMs 이보다 긴 샘플을 스트리밍 (0 = 샘플별 설정이 있는 샘플만)
+     * @param headMs 상주하는 앞부분 길이 (첫 디스크 읽기가 끝날 때까지 재생할 분량)
+     * @param numVoices 동시에 스트리밍할 수 있는 보이스 수 (넘으면 head만 재생)
+     * @param spillFile 디코딩한 tail을 기록할 임시 파일
+     * @return 스트리밍을 켰으면 true
+     */
+    bool setStreaming(double thresholdMs, double headMs, int numVoices, const juce::File& spillFile);
+    
+    /**
+     * 샘플별 스트리밍 임계 길이 (로드 전에 설정, 0 = 이 샘플은 스트리밍 안 함)
+     */
+    void setSampleStreamThreshold(const juce::String& id, double thresholdMs) { streamThresholds[id] = thresholdMs; }
+    
+    SampleStreamer& getStreamer() { return streamer; }
+    const SampleStreamer& getStreamer() const { return streamer; }
+    
+    /**
+     * 스트리밍 샘플 수 / 상주하지 않는 tail 크기 (바이트)
+     */
+    int getNumStreamedSamples() const;
+    size_t getStreamedBytes() const;
+    
+    /**
+     * 현재 아레나 (packSamples() 전이면 nullptr, 오디오 스레드 밖에서 조회)
+     */
+    const SampleArena* getArena() const { return arena.get(); }
+    
     /**
      * 샘플 가져오기
      */
@@ -56,53 +261,228 @@ public:
     juce::StringArray getAllSampleIds() const;
     
     /**
-     * 샘플 게인 설정/가져오기
+     * 샘플 게인 설정/가져오기 (오디오 시작 전에 설정)
+     * @return 샘플이 없으면 false
      */
-    void setSampleGain(const juce::String& id, float gain);
+    bool setSampleGain(const juce::String& id, float gain);
     float getSampleGain(const juce::String& id) const;
     
+    /**
+     * 샘플별 최대 동시 보이스 수 (0 = 플레이어 기본값, 오디오 시작 전에 호출)
+     * @return 샘플이 없으면 false
+     */
+    bool setSampleMaxVoices(const juce::String& id, int maxVoices);
+    
+    /**
+     * 샘플별 무작위 피치 범위 (± 반음, 오디오 시작 전에 호출)
+     * @return 샘플이 없으면 false
+     */
+    bool setSamplePitchRandom(const juce::String& id, float semitones);
+    
 private:
+    /**
+     * 백그라운드 변환 결과 (교체 후에는 이전 버퍼를 보관)
+     * 아레나를 쓰는 중이면 변환하지 않는 샘플도 포함 (새 아레나로 복사, buffer/compact가 모두 비어 있으면 교체 안 함)
+     */
+    struct ConvertedSample {
+        Sample* sample = nullptr;
+        juce::AudioBuffer<float> buffer;
+        CompactPcm compact;     // int16으로 담은 결과 (buffer는 비어 있음)
+        bool resample = false;  // false = 복사만 (레이트 그대로)
+        bool packCompact = false;  // 새 아레나에 int16으로 (변환 스레드가 정함)
+    };
+    
+    enum ConversionState { ConversionIdle, ConversionRunning, ConversionReady, ConversionApplying };
+    enum LoadState { LoadPending, LoadDecoded, LoadFailed, LoadApplied };
+    
+    /**
+     * 병렬 로드 중인 파일 하나 (워커가 buffer를 채운 뒤 state로 넘김, 교환 후에는 샘플의 빈 버퍼를 보관)
+     */
+    struct LoadSlot {
+        Sample* sample = nullptr;
+        juce::File file;
+        juce::AudioBuffer<float> buffer;
+        double sampleRate = 0.0;
+        double sourceSampleRate = 0.0;
+        int sourceBits = 0;
+        double decodeMs = 0.0;
+        double finishedMs = 0.0;
+        const SampleStreamer::Source* stream = nullptr;
+        std::atomic<int> state{LoadPending};
+    };
+    
+    bool resampleToTarget(Sample& sample);  // 변환했으면 true
+    bool storesCompact(const Sample& sample) const;  // int16으로 담을 수 있는 샘플 (값 범위는 따로 확인)
+    int streamHeadFrames(const juce::String& id, int numChannels, int numFrames, double sampleRate) const;  // 0 = 상주
+    const SampleStreamer::Source* splitTail(const juce::String& id, juce::AudioBuffer<float>& buffer, double sampleRate);
+    void startConversion(double sampleRate, bool pack);
+    void finishConversion();
+    void loadWorker();
+    void endLoading();  // 워커 정리 + 통계 (모든 파일이 끝난 뒤)
+    void cancelLoading();
+    
     juce::AudioFormatManager formatManager;
     std::map<juce::String, std::unique_ptr<Sample>> samples;
-    std::map<juce::String, float> sampleGains;
-};
-
-/**
- * 샘플 보이스 (폴리포닉 재생)
- */
-class SampleVoice {
-public:
-    SampleVoice() : isPlaying(false), position(0.0), gain(1.0f) {}
     
-    void trigger(const Sample* sample, float velocity = 1.0f);
-    void stop();
-    bool isActive() const { return isPlaying; }
+    std::unique_ptr<SampleArena> arena;
+    std::unique_ptr<SampleArena> pendingArena;  // 백그라운드 변환 결과 (교체 후에는 이전 아레나)
+    bool useHugePages = false;
+    SampleFormat sampleFormat = SampleFormat::Float32;
     
-    void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, 
-                         int startSample, int numSamples);
+    // 스트리밍 (streamThresholds는 로드 전에만 바뀌므로 로드 워커가 읽어도 됨)
+    SampleStreamer streamer;
+    double streamThresholdMs = 0.0;
+    double streamHeadMs = 500.0;
+    std::map<juce::String, double> streamThresholds;
     
-private:
-    const Sample* currentSample = nullptr;
-    bool isPlaying;
-    double position;
-    float gain;
+    double targetSampleRate = 0.0;
+    std::thread conversionThread;
+    std::vector<ConvertedSample> converted;
+    double convertedRate = 0.0;
+    std::atomic<int> conversionState{ConversionIdle};
+    std::atomic<bool> cancelConversion{false};
+    
+    // 병렬 로드 (loadSlots는 로드 시작/clear() 때만 바뀜, 로드가 끝나도 오디오 스레드가 훑을 수 있어 유지)
+    std::vector<std::unique_ptr<LoadSlot>> loadSlots;
+    std::vector<std::thread> loadThreads;
+    std::atomic<size_t> nextLoadSlot{0};
+    std::atomic<int> numLoadsDone{0};     // 디코딩 성공 + 실패
+    std::atomic<int> numLoadsApplied{0};
+    int loadsSeen = 0;                    // applyLoadedSamples() 호출 스레드 전용
+    std::atomic<double> loadRate{0.0};    // 워커가 변환할 레이트 (로드 중 targetSampleRate)
+    std::atomic<bool> cancelLoad{false};
+    bool loading = false;
+    double loadStartMs = 0.0;
+    LoadStats loadStats;
 };
 
 /**
  * 샘플 플레이어
  * 여러 샘플을 동시에 재생 (폴리포니)
+ *
+ * 보이스 상태는 필드별 연속 배열(SoA)로 보관하고 빈 보이스 목록/활성 보이스 목록을 유지
+ * - 보이스 할당은 빈 목록에서 꺼내는 O(1), 렌더링은 활성 보이스만 순회
+ * - 보이스가 모두 사용 중이면 가장 조용한 (같으면 가장 오래된) 보이스를 짧게 페이드 아웃하며 교체
+ * - 샘플별 보이스 상한: 상한에 닿으면 그 샘플의 가장 오래된 보이스를 페이드 아웃
+ * 페이드 아웃 중인 보이스용으로 STEAL_RESERVE개의 보이스를 더 할당해 두므로
+ * 교체할 때도 새 보이스가 바로 시작됨 (예비 보이스까지 모두 쓰면 가장 많이 줄어든 보이스를 바로 재사용)
+ *
+ * trigger()/renderNextBlock()은 오디오 스레드 전용
  */
 class SamplePlayer {
 public:
+    static constexpr int MAX_VOICES = 4096;
+    static constexpr int STEAL_RESERVE = 8;
+    static constexpr int STEAL_FADE_SAMPLES = 96;  // 48kHz에서 2ms
+    static constexpr int MAX_RENDER_CHANNELS = 8;  // 이보다 많은 출력 채널은 렌더링하지 않음
+    
     SamplePlayer(int maxVoices = 16);
+    ~SamplePlayer();  // 쥐고 있는 스트리머 슬롯 반납 (스트리머보다 먼저 소멸해야 함)
+    
+    /**
+     * 보이스 수 변경 (오디오 시작 전, 재생 중인 보이스는 모두 정지)
+     */
+    void setNumVoices(int maxVoices);
+    int getNumVoices() const { return maxPlaying; }
+    
+    /**
+     * 샘플별 기본 보이스 상한 (Sample::maxVoices가 0인 샘플에 적용, 0 = 상한 없음)
+     */
+    void setMaxVoicesPerSample(int maxVoices) { defaultVoicesPerSample = juce::jmax(0, maxVoices); }
+    
+    /**
+     * 병렬 렌더링 설정 (오디오 시작 전)
+     * 활성 보이스가 minVoices개 이상인 블록만 풀에 나눠 렌더링 (그보다 적으면 분배 비용이 더 큼)
+     * @param pool nullptr = 항상 직렬 렌더링
+     */
+    void setRenderPool(VoiceRenderPool* pool, int minVoices);
+    
+    /**
+     * 출력 샘플레이트 (오디오 시작 전)
+     * 샘플의 레이트가 이와 다르면 (변환 대기 중) 레이트 비율로 보간 재생
+     */
+    void setOutputSampleRate(double sampleRate) { outputSampleRate = sampleRate > 0.0 ? sampleRate : 48000.0; }
+    
+    /**
+     * 재생 속도가 1이 아닌 보이스의 보간 방식 (오디오 시작 전)
+     */
+    void setInterpolation(RenderKernels::Interpolation mode) { interpolation = mode; }
+    RenderKernels::Interpolation getInterpolation() const { return interpolation; }
+    
+    /**
+     * 스트리밍 샘플의 tail을 읽을 스트리머 (오디오 시작 전, nullptr = head만 재생)
+     */
+    void setStreamer(SampleStreamer* newStreamer) { streamer = newStreamer; }
+    
+    /**
+     * 샘플 버퍼가 다른 레이트로 교체됨 (오디오 스레드, SampleManager::applyConvertedSamples)
+     * 이 샘플을 재생 중인 보이스 위치를 ratio배
+     */
+    void rescaleVoices(const Sample* sample, double ratio);
     
-    void trigger(const Sample* sample, float velocity = 1.0f);
+    /**
+     * @param startOffset 블록 내 시작 샘플 위치 (샘플 단위 정확한 트리거)
+     * @param rate 재생 속도 (1 = 원래 피치, 2 = 한 옥타브 위), 1이 아니면 보간 재생
+     */
+    void trigger(const Sample* sample, float velocity = 1.0f, int startOffset = 0, float rate = 1.0f);
     void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, 
                          int startSample, int numSamples);
     
+    /**
+     * 보이스 하나를 출력에 누적 (renderNextBlock 또는 렌더 풀 워커에서 호출)
+     * 보이스마다 한 블록에 한 스레드만 호출, 끝난 보이스는 블록 뒤에 오디오 스레드가 회수
+     */
+    void renderVoice(int voice, juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+    
+    /**
+     * 직전 블록의 활성 보이스 수 (페이드 아웃 중인 보이스 포함)
+     */
+    int getNumActiveVoices() const { return numActive; }
+    
+    /**
+     * 통계: 교체된 보이스 수 (보이스 부족 / 샘플별 상한)
+     */
+    uint64_t getStolenVoices() const { return stolenVoices.load(std::memory_order_relaxed); }
+    uint64_t getCappedVoices() const { return cappedVoices.load(std::memory_order_relaxed); }
+    
 private:
-    std::vector<std::unique_ptr<SampleVoice>> voices;
-    int findFreeVoice();
+    int allocateVoice();
+    void startFadeOut(int voice);
+    void releaseStream(int voice);
+    float renderStreamed(int voice, float* const* out, int channels, int srcChannels, double position,
+                         double step, int frames, float gain, float gainStep);
+    
+    // 보이스별 상태 (인덱스 = 보이스 번호)
+    std::vector<const Sample*> voiceSample;
+    std::vector<double> voicePosition;
+    std::vector<float> voiceRate;       // 재생 속도 (샘플 레이트 비율 제외)
+    std::vector<float> voiceGain;
+    std::vector<int> voiceStartDelay;   // 재생 시작 전 남은 샘플 수
+    std::vector<float> voiceFade;       // 교체 페이드 게인 (1 = 페이드 없음)
+    std::vector<float> voiceFadeStep;   // 샘플당 감소량 (0 = 페이드 아웃 중 아님)
+    std::vector<float> voiceLevel;      // 직전 블록 피크 × 게인 (가장 조용한 보이스 선택용)
+    std::vector<uint64_t> voiceOrder;   // 트리거 순번 (작을수록 오래됨)
+    std::vector<uint8_t> voiceDone;     // 렌더링 중 끝남 (블록 뒤 회수)
+    std::vector<int> voiceStream;       // 스트리머 슬롯 (-1 = 없음, 상주 부분만 재생)
+    
+    std::vector<uint16_t> freeVoices;
+    int numFree = 0;
+    std::vector<uint16_t> activeVoices;
+    int numActive = 0;
+    int numFading = 0;
+    
+    int maxPlaying = 0;                 // 페이드 아웃 중이 아닌 보이스 상한
+    int defaultVoicesPerSample = 0;
+    uint64_t nextOrder = 0;
+    
+    VoiceRenderPool* renderPool = nullptr;
+    int parallelMinVoices = 0;
+    double outputSampleRate = 48000.0;
+    RenderKernels::Interpolation interpolation = RenderKernels::Interpolation::Cubic;
+    SampleStreamer* streamer = nullptr;
+    
+    std::atomic<uint64_t> stolenVoices{0};
+    std::atomic<uint64_t> cappedVoices{0};
 };
 
 } // namespace FXBoard
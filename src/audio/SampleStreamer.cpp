@@ -0,0 +1,299 @@
+#include "SampleStreamer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace FXBoard {
+
+SampleStreamer::~SampleStreamer() {
+    stop();
+}
+
+void SampleStreamer::prepare(int numSlots, int newRingFrames, const juce::File& newSpillFile) {
+    stop();
+
+    ringFrames = juce::jmax(READ_FRAMES, newRingFrames);
+    for (int i = 0; i < numSlots; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->ring.assign(static_cast<size_t>(ringFrames) * MAX_CHANNELS, 0.0f);
+        slot->window.assign(static_cast<size_t>(WINDOW_CAPACITY) * MAX_CHANNELS, 0.0f);
+        slots.push_back(std::move(slot));
+    }
+
+    // 낮은 번호부터 꺼내도록 역순으로
+    freeSlots.resize(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        freeSlots[i] = static_cast<int>(slots.size() - 1 - i);
+    }
+    numFree = static_cast<int>(slots.size());
+
+    // FileOutputStream은 기존 파일 끝에 이어 쓰므로 먼저 지움
+    spillFile = newSpillFile;
+    spillFile.deleteFile();
+    spill = std::make_unique<juce::FileOutputStream>(spillFile);
+    if (spill->failedToOpen()) {
+        juce::Logger::writeToLog("Cannot create stream spill file " + spillFile.getFullPathName() +
+                                 ", long samples stay in memory");
+        spill.reset();
+    } else {
+        spillIndex = addFile(spillFile);
+    }
+
+    startIo();
+}
+
+void SampleStreamer::stop() {
+    stopIo();
+    sources.clear();
+    files.clear();
+    slots.clear();
+    freeSlots.clear();
+    numFree = 0;
+    spillIndex = -1;
+    if (spill != nullptr) {
+        spill.reset();
+        spillFile.deleteFile();
+    }
+}
+
+int SampleStreamer::addFile(const juce::File& file) {
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (files[i]->file == file) return static_cast<int>(i);
+    }
+    auto entry = std::make_unique<StreamFile>();
+    entry->file = file;
+    files.push_back(std::move(entry));
+    return static_cast<int>(files.size() - 1);
+}
+
+const SampleStreamer::Source* SampleStreamer::addTail(const juce::AudioBuffer<float>& buffer, int headFrames) {
+    const int numChannels = buffer.getNumChannels();
+    const int numFrames = buffer.getNumSamples();
+    if (numChannels < 1 || numChannels > MAX_CHANNELS || headFrames <= 0 || headFrames >= numFrames) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(sourceLock);
+    if (spill == nullptr) return nullptr;
+
+    auto source = std::make_unique<Source>();
+    source->file = spillIndex;
+    source->numChannels = numChannels;
+    source->numFrames = numFrames;
+    source->headFrames = headFrames;
+
+    const auto tailBytes = static_cast<size_t>(numFrames - headFrames) * sizeof(float);
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const int64_t position = spill->getPosition();
+        if (!spill->write(buffer.getReadPointer(ch, headFrames), tailBytes)) {
+            juce::Logger::writeToLog("Stream spill file write failed: " + spillFile.getFullPathName());
+            return nullptr;
+        }
+        source->channelOffset[ch] = position - static_cast<int64_t>(headFrames) * static_cast<int64_t>(sizeof(float));
+    }
+    spill->flush();  // I/O 스레드가 다른 핸들로 읽음
+
+    sources.push_back(std::move(source));
+    return sources.back().get();
+}
+
+const SampleStreamer::Source* SampleStreamer::addFileSource(const juce::File& file, int numChannels, int numFrames,
+                                                            int headFrames, int64_t firstChannelOffset,
+                                                            int64_t channelStride) {
+    if (!isEnabled() || numChannels < 1 || numChannels > MAX_CHANNELS || headFrames <= 0 || headFrames >= numFrames) {
+        return nullptr;
+    }
+
+    // files는 I/O 스레드가 읽으므로 멈춘 상태에서 추가
+    stopIo();
+    auto source = std::make_unique<Source>();
+    source->file = addFile(file);
+    source->numChannels = numChannels;
+    source->numFrames = numFrames;
+    source->headFrames = headFrames;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        source->channelOffset[ch] = firstChannelOffset + ch * channelStride;
+    }
+    sources.push_back(std::move(source));
+    startIo();
+    return sources.back().get();
+}
+
+void SampleStreamer::clearSources() {
+    stopIo();
+    for (auto& slot : slots) {
+        slot->source.store(nullptr, std::memory_order_relaxed);
+    }
+    sources.clear();
+    // 스필 파일은 비우지 않음 (남은 tail은 다음 prepare()나 stop() 때 삭제)
+    if (spillIndex >= 0) {
+        files.resize(static_cast<size_t>(spillIndex) + 1);
+    }
+    numFree = static_cast<int>(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i) {
+        freeSlots[i] = static_cast<int>(slots.size() - 1 - i);
+    }
+    if (isEnabled()) {
+        startIo();
+    }
+}
+
+int SampleStreamer::acquire(const Source* source) {
+    if (numFree == 0) {
+        slotMisses.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
+
+    const int index = freeSlots[static_cast<size_t>(--numFree)];
+    Slot& slot = *slots[static_cast<size_t>(index)];
+    ++slot.generation;
+    slot.readFrame.store(source->headFrames, std::memory_order_relaxed);
+    slot.source.store(source, std::memory_order_relaxed);
+    // fill을 본 I/O 스레드는 위 두 값도 봄 (release)
+    slot.fill.store((slot.generation << FRAME_BITS) | static_cast<uint64_t>(source->headFrames),
+                    std::memory_order_release);
+    return index;
+}
+
+void SampleStreamer::release(int index) {
+    Slot& slot = *slots[static_cast<size_t>(index)];
+    slot.source.store(nullptr, std::memory_order_relaxed);
+    ++slot.generation;  // 진행 중인 읽기의 CAS가 실패하도록
+    slot.fill.store(slot.generation << FRAME_BITS, std::memory_order_release);
+    freeSlots[static_cast<size_t>(numFree++)] = index;
+}
+
+void SampleStreamer::read(int index, const juce::AudioBuffer<float>& head, int64_t first, int count,
+                          const float** window) {
+    Slot& slot = *slots[static_cast<size_t>(index)];
+    const Source* source = slot.source.load(std::memory_order_relaxed);
+    const int64_t filled = static_cast<int64_t>(slot.fill.load(std::memory_order_acquire) & FRAME_MASK);
+
+    const int64_t last = first + count;
+    const int64_t headEnd = juce::jmin(last, static_cast<int64_t>(source->headFrames));
+    const int64_t ringEnd = juce::jmin(last, filled);
+    const int64_t dataEnd = juce::jmin(last, static_cast<int64_t>(source->numFrames));
+    bool missing = false;
+
+    for (int ch = 0; ch < source->numChannels; ++ch) {
+        float* dst = slot.window.data() + static_cast<size_t>(ch) * WINDOW_CAPACITY;
+        const float* ring = slot.ring.data() + static_cast<size_t>(ch) * static_cast<size_t>(ringFrames);
+        int64_t frame = first;
+
+        if (frame < headEnd) {
+            const int n = static_cast<int>(headEnd - frame);
+            std::memcpy(dst, head.getReadPointer(ch, static_cast<int>(frame)), static_cast<size_t>(n) * sizeof(float));
+            frame = headEnd;
+        }
+        // 링 구간 (끝에서 감기면 두 번에 나눠 복사)
+        while (frame < ringEnd) {
+            const int offset = static_cast<int>(frame % ringFrames);
+            const int n = static_cast<int>(juce::jmin(ringEnd - frame, static_cast<int64_t>(ringFrames - offset)));
+            std::memcpy(dst + (frame - first), ring + offset, static_cast<size_t>(n) * sizeof(float));
+            frame += n;
+        }
+        if (frame < last) {
+            missing = missing || frame < dataEnd;
+            std::fill(dst + (frame - first), dst + count, 0.0f);
+        }
+        window[ch] = dst;
+    }
+
+    if (missing) {
+        underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void SampleStreamer::consumed(int index, int64_t frame) {
+    Slot& slot = *slots[static_cast<size_t>(index)];
+    if (frame > slot.readFrame.load(std::memory_order_relaxed)) {
+        slot.readFrame.store(frame, std::memory_order_release);
+    }
+}
+
+size_t SampleStreamer::getRingBytes() const {
+    size_t bytes = 0;
+    for (const auto& slot : slots) {
+        bytes += (slot->ring.size() + slot->window.size()) * sizeof(float);
+    }
+    return bytes;
+}
+
+void SampleStreamer::startIo() {
+    if (ioThread.joinable()) return;
+    ioRunning.store(true, std::memory_order_relaxed);
+    ioThread = std::thread([this] { ioLoop(); });
+}
+
+void SampleStreamer::stopIo() {
+    ioRunning.store(false, std::memory_order_relaxed);
+    if (ioThread.joinable()) {
+        ioThread.join();
+    }
+}
+
+void SampleStreamer::ioLoop() {
+    while (ioRunning.load(std::memory_order_relaxed)) {
+        bool busy = false;
+        for (auto& slot : slots) {
+            busy = fillSlot(*slot) || busy;
+        }
+        if (!busy) {
+            // 링이 모두 차 있으면 잠깐 쉼 (head 길이에 비해 충분히 짧게)
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+    // 다음 시작 때 파일을 다시 엶 (원본 목록이 바뀌었을 수 있음)
+    for (auto& file : files) {
+        file->input.reset();
+    }
+}
+
+bool SampleStreamer::fillSlot(Slot& slot) {
+    uint64_t state = slot.fill.load(std::memory_order_acquire);
+    const Source* source = slot.source.load(std::memory_order_relaxed);
+    if (source == nullptr) return false;
+
+    const uint64_t generation = state >> FRAME_BITS;
+    const int64_t readFrame = slot.readFrame.load(std::memory_order_acquire);
+    int64_t frame = static_cast<int64_t>(state & FRAME_MASK);
+    if (frame < readFrame) {
+        frame = readFrame;  // 언더런으로 소비자가 앞서 나감: 지나간 구간은 건너뜀
+    }
+
+    const int64_t end = juce::jmin(readFrame + ringFrames, static_cast<int64_t>(source->numFrames));
+    const int count = static_cast<int>(juce::jmin(end - frame, static_cast<int64_t>(READ_FRAMES)));
+    if (count <= 0 || (count < MIN_READ_FRAMES && end < source->numFrames)) {
+        return false;
+    }
+
+    auto& file = *files[static_cast<size_t>(source->file)];
+    if (file.input == nullptr) {
+        file.input = std::make_unique<juce::FileInputStream>(file.file);
+    }
+    if (file.input->failedToOpen()) {
+        return false;
+    }
+
+    for (int ch = 0; ch < source->numChannels; ++ch) {
+        float* ring = slot.ring.data() + static_cast<size_t>(ch) * static_cast<size_t>(ringFrames);
+        int64_t f = frame;
+        while (f < frame + count) {
+            const int offset = static_cast<int>(f % ringFrames);
+            const int n = static_cast<int>(juce::jmin(frame + count - f, static_cast<int64_t>(ringFrames - offset)));
+            const int bytes = n * static_cast<int>(sizeof(float));
+            if (!file.input->setPosition(source->channelOffset[ch] + f * static_cast<int64_t>(sizeof(float))) ||
+                file.input->read(ring + offset, bytes) != bytes) {
+                return false;
+            }
+            f += n;
+        }
+    }
+
+    // 그 사이 슬롯이 풀리거나 다른 보이스에 배정됐으면 실패 (읽은 데이터는 버려짐)
+    const uint64_t filled = (generation << FRAME_BITS) | static_cast<uint64_t>(frame + count);
+    slot.fill.compare_exchange_strong(state, filled, std::memory_order_release, std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace FXBoard
@@ -0,0 +1,157 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FXBoard {
+
+/**
+ * 긴 샘플의 디스크 스트리밍
+ *
+ * 스트리밍 샘플은 앞부분(head)만 메모리에 두고 나머지(tail)는 재생할 때 파일에서 읽음
+ * - 원본: 디바이스 레이트로 변환한 float PCM (로드 시 기록한 스필 파일, 또는 샘플 뱅크 파일 그대로)
+ * - 스트리밍 보이스마다 슬롯 하나 (링 버퍼, 생산자 = I/O 스레드 / 소비자 = 보이스를 렌더링하는 스레드)
+ * - 링은 절대 프레임 번호로 관리: I/O 스레드는 소비 위치 + 링 크기까지 미리 채우고
+ *   (세대 << 40 | 끝 프레임)을 CAS로 공개하므로 슬롯이 재사용되면 이전 읽기는 버려짐
+ * - 보이스가 head를 재생하는 동안 첫 읽기가 끝나야 함, 필요한 구간이 아직 없으면 0으로 채우고 언더런으로 셈
+ * 메모리 = 슬롯 수 × 링 크기 (키트 크기와 무관)
+ *
+ * acquire()/release()는 오디오 스레드 전용, read()/consumed()는 슬롯을 가진 보이스를 렌더링하는 스레드
+ */
+class SampleStreamer {
+public:
+    static constexpr int MAX_CHANNELS = 2;
+    static constexpr int HISTORY = 3;          // 보간용으로 재생 위치 앞에 남겨 두는 프레임 (sinc 8탭)
+    static constexpr int LOOKAHEAD = 5;        // 보간용 뒤쪽 여유
+    static constexpr int WINDOW_FRAMES = 2048; // 렌더링 한 조각이 지나가는 최대 소스 프레임
+    static constexpr int WINDOW_CAPACITY = WINDOW_FRAMES + HISTORY + LOOKAHEAD + 2;
+
+    /**
+     * 스트리밍 원본 (tail이 들어 있는 파일 위치)
+     */
+    struct Source {
+        int file = -1;
+        int numChannels = 0;
+        int numFrames = 0;   // 전체 길이
+        int headFrames = 0;  // 메모리에 상주하는 앞부분
+        int64_t channelOffset[MAX_CHANNELS] = {};  // 채널별 프레임 0의 파일 위치 (바이트, 음수일 수 있음)
+    };
+
+    SampleStreamer() = default;
+    ~SampleStreamer();
+
+    SampleStreamer(const SampleStreamer&) = delete;
+    SampleStreamer& operator=(const SampleStreamer&) = delete;
+
+    /**
+     * 슬롯/링 할당 + I/O 스레드 시작 (오디오 정지 상태에서)
+     * @param numSlots 동시에 스트리밍할 수 있는 보이스 수
+     * @param ringFrames 슬롯당 링 크기 (프레임)
+     * @param spillFile tail을 기록할 파일 (이미 있으면 덮어씀, stop() 때 삭제)
+     */
+    void prepare(int numSlots, int ringFrames, const juce::File& spillFile);
+
+    /**
+     * I/O 스레드 정지, 원본/슬롯/스필 파일 해제 (오디오 정지 상태에서)
+     */
+    void stop();
+
+    bool isEnabled() const { return !slots.empty(); }
+
+    /**
+     * tail을 스필 파일에 기록하고 원본으로 등록 (로드 워커 스레드에서 호출 가능)
+     * @return 실패하면 nullptr (샘플은 전체 상주)
+     */
+    const Source* addTail(const juce::AudioBuffer<float>& buffer, int headFrames);
+
+    /**
+     * 파일 안에 이미 있는 PCM을 원본으로 등록 (샘플 뱅크, 오디오 정지 상태에서)
+     * @param firstChannelOffset 첫 채널 프레임 0의 파일 위치
+     * @param channelStride 채널 사이 간격 (바이트)
+     */
+    const Source* addFileSource(const juce::File& file, int numChannels, int numFrames, int headFrames,
+                                int64_t firstChannelOffset, int64_t channelStride);
+
+    /**
+     * 원본 모두 제거 (오디오 정지 상태에서, 슬롯과 스필 파일은 유지)
+     */
+    void clearSources();
+
+    /**
+     * 빈 슬롯을 원본에 배정 (오디오 스레드)
+     * @return 슬롯 번호, 빈 슬롯이 없으면 -1 (보이스는 head만 재생)
+     */
+    int acquire(const Source* source);
+    void release(int slot);
+
+    /**
+     * 소스 프레임 [first, first + count)를 슬롯의 창 버퍼로 모음 (count <= WINDOW_CAPACITY)
+     * head 구간은 head 버퍼에서, 나머지는 링에서 복사하고 아직 읽지 못한 프레임은 0 (언더런)
+     * @param window 채널별 창 포인터 (원본 채널 수만큼)
+     */
+    void read(int slot, const juce::AudioBuffer<float>& head, int64_t first, int count, const float** window);
+
+    /**
+     * 이 프레임 앞은 더 필요 없음 (I/O 스레드가 덮어써도 됨)
+     */
+    void consumed(int slot, int64_t frame);
+
+    int getNumSlots() const { return static_cast<int>(slots.size()); }
+    size_t getRingBytes() const;
+
+    /**
+     * 통계: 디스크 읽기가 재생을 따라가지 못해 0을 낸 블록 수 / 빈 슬롯이 없어 head만 재생한 보이스 수
+     */
+    uint64_t getUnderruns() const { return underruns.load(std::memory_order_relaxed); }
+    uint64_t getSlotMisses() const { return slotMisses.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int FRAME_BITS = 40;
+    static constexpr uint64_t FRAME_MASK = (uint64_t(1) << FRAME_BITS) - 1;
+    static constexpr int READ_FRAMES = 16384;  // 한 번에 읽는 최대 프레임
+    static constexpr int MIN_READ_FRAMES = 2048;
+
+    struct Slot {
+        std::atomic<const Source*> source{nullptr};
+        std::atomic<uint64_t> fill{0};       // (세대 << FRAME_BITS) | 링에 채운 끝 프레임
+        std::atomic<int64_t> readFrame{0};   // 소비자가 필요한 첫 프레임
+        std::vector<float> ring;             // 채널별 ringFrames
+        std::vector<float> window;           // 채널별 WINDOW_CAPACITY
+        uint64_t generation = 0;             // 오디오 스레드 전용
+    };
+
+    struct StreamFile {
+        juce::File file;
+        std::unique_ptr<juce::FileInputStream> input;  // I/O 스레드 전용
+    };
+
+    int addFile(const juce::File& file);
+    void startIo();
+    void stopIo();
+    void ioLoop();
+    bool fillSlot(Slot& slot);
+
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<int> freeSlots;  // 오디오 스레드 전용
+    int numFree = 0;
+    int ringFrames = 0;
+
+    std::mutex sourceLock;  // 로드 워커들의 addTail()
+    std::vector<std::unique_ptr<Source>> sources;
+    std::vector<std::unique_ptr<StreamFile>> files;
+    juce::File spillFile;
+    std::unique_ptr<juce::FileOutputStream> spill;
+    int spillIndex = -1;
+
+    std::thread ioThread;
+    std::atomic<bool> ioRunning{false};
+
+    std::atomic<uint64_t> underruns{0};
+    std::atomic<uint64_t> slotMisses{0};
+};
+
+} // namespace FXBoard
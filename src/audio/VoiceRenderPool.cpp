@@ -0,0 +1,219 @@
+#include "VoiceRenderPool.h"
+#include "SampleManager.h"
+#include "../core/Realtime.h"
+#include <climits>
+
+#if JUCE_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace FXBoard {
+
+namespace {
+
+// 워커가 잠들기 전 스핀 횟수 (수 마이크로초, 연속된 블록 사이의 짧은 공백은 깨우기 비용 없이 처리)
+constexpr int SPIN_ITERATIONS = 4000;
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+inline void futexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+#if JUCE_LINUX
+    // 값이 이미 바뀌었으면 커널이 바로 반환
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    if (word.load(std::memory_order_acquire) == expected) {
+        std::this_thread::yield();
+    }
+#endif
+}
+
+inline void futexWakeAll(std::atomic<uint32_t>& word) {
+#if JUCE_LINUX
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void) word;
+#endif
+}
+
+} // namespace
+
+VoiceRenderPool::~VoiceRenderPool() {
+    stop();
+}
+
+bool VoiceRenderPool::start(int numWorkers, int numChannels, int priority, int firstCpu) {
+    stop();
+
+    numWorkers = juce::jlimit(0, MAX_WORKERS, numWorkers);
+    if (numWorkers == 0 || numChannels <= 0) {
+        return false;
+    }
+
+    scratchChannels = numChannels;
+    running.store(true);
+
+    // 모든 워커를 먼저 만든 뒤 스레드 시작 (vector 재할당 중 워커가 돌지 않도록)
+    for (int i = 0; i < numWorkers; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->scratch.setSize(numChannels, MAX_BLOCK_SIZE);
+        worker->scratch.clear();
+        workers.push_back(std::move(worker));
+    }
+    for (int i = 0; i < numWorkers; ++i) {
+        int cpu = firstCpu >= 0 ? firstCpu + i : -1;
+        workers[static_cast<size_t>(i)]->thread =
+            std::thread(&VoiceRenderPool::runWorker, this, std::ref(*workers[static_cast<size_t>(i)]), i, priority, cpu);
+    }
+
+    juce::Logger::writeToLog("Voice render pool: " + juce::String(numWorkers) + " workers" +
+                             (firstCpu >= 0 ? ", CPUs " + juce::String(firstCpu) + "-" +
+                                                  juce::String(firstCpu + numWorkers - 1)
+                                            : juce::String()));
+    return true;
+}
+
+void VoiceRenderPool::stop() {
+    if (workers.empty()) {
+        return;
+    }
+
+    running.store(false);
+    generation.fetch_add(1);
+    futexWakeAll(generation);
+
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    workers.clear();
+}
+
+void VoiceRenderPool::render(SamplePlayer& player, const uint16_t* voices, int numVoices,
+                             juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) {
+    if (numVoices <= 0) return;
+    numVoices = juce::jmin(numVoices, MAX_JOB_VOICES);
+
+    // 작업 공개: 파라미터 → 작업 워드 (release) → 세대 (워커 깨우기)
+    const uint32_t gen = generation.load(std::memory_order_relaxed) + 1;
+    jobPlayer = &player;
+    jobVoices = voices;
+    jobOutput = &outputBuffer;
+    jobStart = startSample;
+    jobSamples = numSamples;
+    completed.store(0, std::memory_order_relaxed);
+    jobWord.store(packJob(gen, 0, static_cast<uint32_t>(numVoices)), std::memory_order_release);
+
+    // seq_cst: 세대 저장과 sleepers 읽기가 워커 쪽 (sleepers 증가 → 세대 확인)과 엇갈리지 않도록
+    generation.store(gen);
+    if (sleepers.load() > 0) {
+        futexWakeAll(generation);
+    }
+
+    // 오디오 스레드도 보이스를 가져가 출력에 직접 렌더링
+    renderClaimed(nullptr, gen);
+
+    // 워커가 가져간 보이스만 기다림 (가져가지 않은 보이스는 위에서 모두 처리됨)
+    while (completed.load(std::memory_order_acquire) < numVoices) {
+        cpuRelax();
+    }
+
+    uint64_t fromWorkers = 0;
+    for (auto& worker : workers) {
+        if (worker->contributedGeneration.load(std::memory_order_relaxed) != gen) continue;
+        for (int ch = 0; ch < scratchChannels; ++ch) {
+            outputBuffer.addFrom(ch, startSample, worker->scratch, ch, startSample, numSamples);
+        }
+        fromWorkers += worker->renderedVoices;
+        worker->renderedVoices = 0;
+    }
+
+    workerVoices.store(workerVoices.load(std::memory_order_relaxed) + fromWorkers, std::memory_order_relaxed);
+    totalVoices.store(totalVoices.load(std::memory_order_relaxed) + static_cast<uint64_t>(numVoices),
+                      std::memory_order_relaxed);
+}
+
+int VoiceRenderPool::claim(uint32_t gen) {
+    uint64_t word = jobWord.load(std::memory_order_acquire);
+    for (;;) {
+        if (static_cast<uint32_t>(word >> 32) != gen) return -1;
+        const auto next = static_cast<uint32_t>((word >> 16) & 0xffff);
+        const auto count = static_cast<uint32_t>(word & 0xffff);
+        if (next >= count) return -1;
+
+        if (jobWord.compare_exchange_weak(word, word + (uint64_t{1} << 16),
+                                          std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return static_cast<int>(next);
+        }
+    }
+}
+
+void VoiceRenderPool::renderClaimed(Worker* worker, uint32_t gen) {
+    for (;;) {
+        const int index = claim(gen);
+        if (index < 0) break;
+
+        const int voice = jobVoices[index];
+        if (worker == nullptr) {
+            jobPlayer->renderVoice(voice, *jobOutput, jobStart, jobSamples);
+        } else {
+            // 이 블록에서 처음 가져간 보이스면 스크래치 구간을 비움
+            if (worker->contributedGeneration.load(std::memory_order_relaxed) != gen) {
+                for (int ch = 0; ch < scratchChannels; ++ch) {
+                    worker->scratch.clear(ch, jobStart, jobSamples);
+                }
+                worker->contributedGeneration.store(gen, std::memory_order_relaxed);
+            }
+            jobPlayer->renderVoice(voice, worker->scratch, jobStart, jobSamples);
+            ++worker->renderedVoices;
+        }
+
+        // release: 스크래치 쓰기와 contributedGeneration이 오디오 스레드의 합산보다 먼저 보이도록
+        completed.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void VoiceRenderPool::runWorker(Worker& worker, int index, int priority, int cpu) {
+    if (priority > 0) {
+        juce::String name = "Render " + juce::String(index);
+        Realtime::configureCurrentThread(priority, cpu, name.toRawUTF8());
+    }
+
+    uint32_t seen = generation.load(std::memory_order_acquire);
+
+    while (running.load(std::memory_order_acquire)) {
+        // 잠깐 스핀 후 futex 대기
+        uint32_t gen = seen;
+        for (int spin = 0; spin < SPIN_ITERATIONS && gen == seen; ++spin) {
+            cpuRelax();
+            gen = generation.load(std::memory_order_acquire);
+        }
+        while (gen == seen && running.load(std::memory_order_acquire)) {
+            sleepers.fetch_add(1);
+            if (generation.load() == seen) {
+                futexWait(generation, seen);
+            }
+            sleepers.fetch_sub(1);
+            gen = generation.load(std::memory_order_acquire);
+        }
+
+        seen = gen;
+        if (!running.load(std::memory_order_acquire)) break;
+
+        renderClaimed(&worker, gen);
+    }
+}
+
+} // namespace FXBoard
@@ -0,0 +1,121 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace FXBoard {
+
+class SamplePlayer;
+
+/**
+ * 병렬 보이스 렌더링용 워커 풀 (블록 단위 fork/join)
+ *
+ * 오디오 스레드가 활성 보이스 목록을 공개하면 워커들과 오디오 스레드가
+ * 보이스를 하나씩 가져가 렌더링 (원자적 CAS로 분배, 락 없음)
+ * - 워커는 자기 스크래치 버퍼에 누적, 오디오 스레드는 출력 버퍼에 직접 누적
+ * - 오디오 스레드는 가져간 보이스가 모두 끝날 때까지만 기다린 뒤 스크래치를 합산
+ * - 늦게 깨어난 워커는 다음 블록 작업을 건드리지 못함 (작업 워드에 세대 번호 포함)
+ * 따라서 워커가 선점되거나 늦게 깨어나도 오디오 스레드가 남은 보이스를 대신 처리
+ *
+ * 워커는 잠깐 스핀한 뒤 futex로 잠들고, 오디오 스레드는 잠든 워커가 있을 때만 깨움
+ */
+class VoiceRenderPool {
+public:
+    static constexpr int MAX_WORKERS = 15;
+    static constexpr int MAX_BLOCK_SIZE = 4096;
+    static constexpr int MAX_JOB_VOICES = 0xffff;
+
+    VoiceRenderPool() = default;
+    ~VoiceRenderPool();
+
+    VoiceRenderPool(const VoiceRenderPool&) = delete;
+    VoiceRenderPool& operator=(const VoiceRenderPool&) = delete;
+
+    /**
+     * 워커 스레드 시작 (메인 스레드, 오디오 시작 전)
+     * @param numWorkers 워커 수 (오디오 스레드는 따로 참여하므로 코어 수 - 1 정도)
+     * @param numChannels 출력 채널 수 (스크래치 버퍼 크기)
+     * @param priority 워커 SCHED_FIFO 우선순위 (0 = 일반 스케줄링)
+     * @param firstCpu 첫 워커를 고정할 코어, 이후 워커는 다음 코어 (-1 = 고정 안 함)
+     * @return 워커가 하나 이상 시작되면 true
+     */
+    bool start(int numWorkers, int numChannels, int priority = 0, int firstCpu = -1);
+
+    /**
+     * 워커 정지 (메인 스레드, 오디오 정지 후)
+     */
+    void stop();
+
+    bool isRunning() const { return !workers.empty(); }
+    int getNumWorkers() const { return static_cast<int>(workers.size()); }
+
+    /**
+     * 이 블록을 병렬로 렌더링할 수 있는지 (채널 수/블록 크기가 스크래치에 맞는지)
+     */
+    bool canRender(int numChannels, int startSample, int numSamples) const {
+        return isRunning() && numChannels == scratchChannels && startSample + numSamples <= MAX_BLOCK_SIZE;
+    }
+
+    /**
+     * 플레이어의 보이스들을 렌더링해 출력에 합산 (오디오 스레드, 한 번에 한 스레드만)
+     * 반환 시점에 모든 보이스의 렌더링이 끝나 있음
+     * @param voices 렌더링할 보이스 번호 (SamplePlayer::renderVoice 인자)
+     */
+    void render(SamplePlayer& player, const uint16_t* voices, int numVoices,
+                juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples);
+
+    /**
+     * 통계: 워커가 렌더링한 보이스 수 (나머지는 오디오 스레드가 처리)
+     */
+    uint64_t getWorkerVoices() const { return workerVoices.load(std::memory_order_relaxed); }
+    uint64_t getTotalVoices() const { return totalVoices.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Worker {
+        std::thread thread;
+        juce::AudioBuffer<float> scratch;
+        std::atomic<uint32_t> contributedGeneration{0};  // 이 세대에 스크래치에 쓴 적 있으면 세대 번호
+        uint64_t renderedVoices = 0;
+    };
+
+    /**
+     * 작업 워드: [세대 32비트 | 다음 인덱스 16비트 | 보이스 수 16비트]
+     * 세대가 다르면 CAS가 실패하므로 이전 세대를 본 워커는 새 작업을 가져갈 수 없음
+     */
+    static uint64_t packJob(uint32_t generation, uint32_t next, uint32_t count) {
+        return (static_cast<uint64_t>(generation) << 32) | (static_cast<uint64_t>(next) << 16) | count;
+    }
+
+    /**
+     * 현재 세대에서 보이스 하나를 가져옴
+     * @return 보이스 인덱스, 남은 보이스가 없거나 세대가 바뀌었으면 -1
+     */
+    int claim(uint32_t generation);
+
+    void runWorker(Worker& worker, int index, int priority, int cpu);
+    void renderClaimed(Worker* worker, uint32_t generation);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    int scratchChannels = 0;
+
+    // 현재 작업 (오디오 스레드가 jobWord 공개 전에 씀, 가져간 보이스가 끝날 때까지 유효)
+    SamplePlayer* jobPlayer = nullptr;
+    const uint16_t* jobVoices = nullptr;
+    juce::AudioBuffer<float>* jobOutput = nullptr;
+    int jobStart = 0;
+    int jobSamples = 0;
+
+    alignas(64) std::atomic<uint64_t> jobWord{0};
+    alignas(64) std::atomic<uint32_t> generation{0};  // 워커 대기용 (futex 주소)
+    std::atomic<int> sleepers{0};
+    std::atomic<bool> running{false};
+    alignas(64) std::atomic<int> completed{0};
+
+    std::atomic<uint64_t> workerVoices{0};
+    std::atomic<uint64_t> totalVoices{0};
+};
+
+} // namespace FXBoard
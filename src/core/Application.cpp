@@ -1,5 +1,10 @@
 #include "Application.h"
+#include "OfflineRenderer.h"
+#include "../audio/AlsaOutputDevice.h"
+#include "../audio/SampleBank.h"
+#include "RtLog.h"
 #include <juce_core/juce_core.h>
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -15,45 +20,151 @@ Application::~Application() {
 
 bool Application::initialize(const std::string& configPath) {
     std::cout << "=== FXBoard Initializing ===" << std::endl;
+    startupStartMs = juce::Time::getMillisecondCounterHiRes();
+    
+    // Background formatter for logs from the input/audio threads
+    RtLog::start();
+    initialized = true;  // from here on shutdown() has something to undo, even if initialize() fails
     
     // Load configuration
     loadConfiguration(configPath);
+    markStartup("config");
+    
+    // Offline render / bank compile: engine, samples and mappings only - no device, keyboard or RT setup
+    if (!renderEventsPath.empty() || compileBankRequested) {
+        audioEngine = std::make_unique<AudioEngine>();
+        configureEngine();
+        // Convert samples to the render rate while loading
+        audioEngine->getSampleManager().setTargetSampleRate(configManager.getSectionProperty("Audio", "sampleRate", 48000.0));
+        loadSamples();
+        applySampleSettings();
+        setupKeyMappings();
+        finishSampleLoading();
+        markStartup("samples loaded");
+        if (verbose) {
+            printStartupTiming();
+        }
+        running.store(true);
+        return true;
+    }
+    
+    // Real-time mode (memory locking, C-state blocking)
+    setupRealtime();
+    markStartup("real-time setup");
     
     // Initialize audio engine
     audioEngine = std::make_unique<AudioEngine>();
+    if (realtimeConfig.enabled) {
+        audioEngine->setRealtime(realtimeConfig.audioPriority, realtimeConfig.audioCpu);
+    }
+    configureEngine();
+    
+    double sampleRate = configManager.getSectionProperty("Audio", "sampleRate", 48000.0);
     
-    int bufferSize = 128;  // Default low-latency buffer
-    if (!audioEngine->initialize(bufferSize)) {
-        std::cerr << "Error: Failed to initialize audio device" << std::endl;
+    // Start decoding at the configured rate; the worker threads run while the device opens below.
+    // If the device ends up at another rate, samples are converted once loading completes.
+    audioEngine->getSampleManager().setTargetSampleRate(sampleRate);
+    loadSamples();
+    markStartup("sample loading started");
+    
+    int bufferSize = configManager.getSectionProperty("Audio", "bufferSize", 128);
+    juce::String backend = configManager.getSectionProperty("Audio", "backend", "juce").toString();
+    
+    if (backend == "alsa") {
+        // Direct ALSA mmap output: explicit period size and count
+        auto device = std::make_unique<AlsaOutputDevice>(
+            configManager.getSectionProperty("Audio", "alsaDevice", "hw:0,0").toString(),
+            bufferSize,
+            configManager.getSectionProperty("Audio", "periods", 2));
+        
+        if (!audioEngine->initializeWithDevice(std::move(device), sampleRate, bufferSize)) {
+            std::cerr << "Error: Failed to open ALSA device (check audio.alsaDevice)" << std::endl;
+            return false;
+        }
+    } else if (!audioEngine->initialize(sampleRate, bufferSize,
+                                        configManager.getSectionProperty("Audio", "deviceName", "").toString(),
+                                        configManager.getSectionProperty("Audio", "outputChannels", 2))) {
+        std::cerr << "Error: Failed to initialize audio device (check audio.deviceName)" << std::endl;
         return false;
     }
     std::cout << "✓ Audio engine initialized" << std::endl;
+    markStartup("device open");
     
-    // Initialize keyboard hook
-    keyHook = std::make_unique<KeyHook>();
+    // Initialize keyboard hook (writes straight into the audio engine's queue)
+    keyHook = std::make_unique<KeyHook>(audioEngine->getEventQueue());
+    if (realtimeConfig.enabled) {
+        keyHook->setRealtime(realtimeConfig.inputPriority, realtimeConfig.inputCpu);
+    }
     
-    // Load samples
-    loadSamples();
+    // Input session record/replay
+    if (!recordPath.empty()) {
+        sessionRecorder = std::make_unique<SessionRecorder>();
+        if (!sessionRecorder->start(juce::File(recordPath))) {
+            std::cerr << "Error: Cannot record session to " << recordPath << std::endl;
+            return false;
+        }
+        keyHook->setRecorder(sessionRecorder.get());
+    }
+    
+    if (!replayPath.empty()) {
+        sessionReplayer = std::make_unique<SessionReplayer>(audioEngine->getEventQueue());
+        if (!sessionReplayer->load(juce::File(replayPath))) {
+            std::cerr << "Error: Cannot load session " << replayPath << std::endl;
+            return false;
+        }
+        sessionReplayer->setSpeed(replaySpeed);
+        if (realtimeConfig.enabled) {
+            sessionReplayer->setRealtime(realtimeConfig.inputPriority, realtimeConfig.inputCpu);
+        }
+    }
+    
+    // Per-sample gain/voice settings (entries exist even while their files are still decoding)
+    applySampleSettings();
     
     // Setup key mappings
     setupKeyMappings();
     
+    // Input starts once the mapped samples can play; the rest keeps decoding and is
+    // handed to the audio thread as it finishes
+    waitForMappedSamples();
+    markStartup("mapped samples ready");
+    
     // Start audio engine
     audioEngine->start();
     std::cout << "✓ Audio engine started" << std::endl;
+    markStartup("audio started");
+    
+    setupAdaptiveBuffer();
     
     // Start keyboard hook
     if (!keyHook->start()) {
         std::cerr << "Warning: Keyboard hook failed to start" << std::endl;
         std::cerr << "  Make sure you have permission to access /dev/input/event*" << std::endl;
         std::cerr << "  Run: sudo ./scripts/setup_permissions.sh" << std::endl;
-        return false;
+        // Replay does not need a keyboard
+        if (!sessionReplayer) {
+            return false;
+        }
+    } else {
+        std::cout << "✓ Keyboard hook started" << std::endl;
+    }
+    
+    // MIDI pads (optional, writes into the same queue)
+    setupMidi();
+    
+    // Start replay last so the first events are not queued before the device runs
+    if (sessionReplayer && sessionReplayer->start()) {
+        std::cout << "✓ Replaying session at " << replaySpeed << "x ("
+                  << sessionReplayer->getNumEvents() << " events)" << std::endl;
     }
-    std::cout << "✓ Keyboard hook started" << std::endl;
     
     running.store(true);
+    markStartup("input ready");
     
     printStatus();
+    if (verbose) {
+        printStartupTiming();
+    }
     
     return true;
 }
@@ -67,27 +178,173 @@ void Application::run() {
     while (running.load()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
         
-        // Could add periodic status updates here if needed
+        if (latencyReportRequested.exchange(false)) {
+            printLatencyReport();
+        }
+        
+        if (adaptiveBuffer) {
+            updateAdaptiveBuffer();
+        }
+        
+        pollSampleLoading();
+        
+        if (sessionReplayer && sessionReplayer->isFinished()) {
+            std::cout << "\nReplay finished" << std::endl;
+            // Let the last voices reach the output before stopping
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            running.store(false);
+        }
     }
     
     std::cout << "\nShutting down..." << std::endl;
 }
 
+bool Application::renderOffline() {
+    if (!audioEngine) {
+        return false;
+    }
+    
+    double sampleRate = configManager.getSectionProperty("Audio", "sampleRate", 48000.0);
+    int bufferSize = configManager.getSectionProperty("Audio", "bufferSize", 128);
+    
+    OfflineRenderer renderer(*audioEngine);
+    if (!renderer.loadEvents(juce::File(renderEventsPath))) {
+        return false;
+    }
+    
+    std::cout << "\n=== FXBoard Offline Render ===" << std::endl;
+    std::cout << "Rendering at " << sampleRate << " Hz, " << bufferSize << "-sample blocks..." << std::endl;
+    
+    if (!renderer.render(juce::File(renderOutputPath), sampleRate, bufferSize)) {
+        return false;
+    }
+    
+    std::cout << "✓ Wrote " << juce::String(renderer.getRenderedSeconds(), 2) << " s to " << renderOutputPath << std::endl;
+    std::cout << "  Engine time: " << juce::String(renderer.getProcessingSeconds() * 1000.0, 1) << " ms ("
+              << juce::String(renderer.getRealtimeFactor(), 1) << "x realtime)" << std::endl;
+    std::cout << "  Key-downs processed: " << audioEngine->getKeyDownsProcessed()
+              << ", peak " << juce::String(juce::Decibels::gainToDecibels(renderer.getPeakLevel()), 1) << " dBFS" << std::endl;
+    return true;
+}
+
+bool Application::compileSampleBank() {
+    if (!audioEngine) {
+        return false;
+    }
+    
+    auto& sampleManager = audioEngine->getSampleManager();
+    if (sampleManager.getNumSamples() == 0) {
+        std::cerr << "Error: no samples to compile" << std::endl;
+        return false;
+    }
+    if (sampleBankFile == juce::File()) {
+        std::cerr << "Error: audio.sampleBank is empty, nowhere to write the bank" << std::endl;
+        return false;
+    }
+    
+    juce::String error;
+    if (!sampleManager.writeBank(sampleBankFile, sampleSourceHash, error)) {
+        std::cerr << "Error: cannot write sample bank: " << error << std::endl;
+        return false;
+    }
+    
+    std::cout << "✓ Compiled " << sampleManager.getNumSamples() << " samples at "
+              << juce::String(sampleManager.getTargetSampleRate(), 0) << " Hz into "
+              << sampleBankFile.getFullPathName() << " ("
+              << juce::String(static_cast<double>(sampleBankFile.getSize()) / (1024.0 * 1024.0), 1) << " MB)" << std::endl;
+    return true;
+}
+
 void Application::shutdown() {
-    if (!running.load()) {
+    // Keyed off initialization, not running: Ctrl+C, replay end and a failed initialize()
+    // all clear running before shutdown() is reached
+    if (!initialized) {
         return;
     }
+    initialized = false;
     
     running.store(false);
     
+    if (sessionReplayer) {
+        sessionReplayer->stop();
+    }
+    
     if (keyHook) {
         keyHook->stop();
     }
     
+    if (midiInput) {
+        midiInput->stop();
+    }
+    
+    // Producers are stopped above, so nothing calls record() while the recorder drains and flushes
+    if (sessionRecorder) {
+        sessionRecorder->stop();
+    }
+    
     if (audioEngine) {
         audioEngine->stop();
     }
     
+    cpuDmaLatency.release();
+    
+    if (RtLog::getDroppedRecords() > 0) {
+        std::cout << "Log records dropped: " << RtLog::getDroppedRecords() << std::endl;
+    }
+    RtLog::stop();
+    
+    if (keyHook && audioEngine) {
+        std::cout << "Key-downs: sent " << keyHook->getKeyDownsSent()
+                  << ", processed " << audioEngine->getKeyDownsProcessed()
+                  << ", late " << audioEngine->getLateKeyDowns()
+                  << ", dropped " << keyHook->getDroppedEvents()
+                  << " (SYN_DROPPED frames " << keyHook->getDroppedFrames() << ")" << std::endl;
+    }
+    
+    if (audioEngine) {
+        std::cout << "Xruns: " << audioEngine->getXRunCount() << " callback gaps, "
+                  << audioEngine->getDeviceXRunCount() << " reported by device" << std::endl;
+        
+        const auto& player = audioEngine->getSamplePlayer();
+        std::cout << "Voices: " << player.getStolenVoices() << " stolen, "
+                  << player.getCappedVoices() << " replaced by per-sample limit" << std::endl;
+        
+        const auto& streamer = audioEngine->getSampleManager().getStreamer();
+        if (streamer.isEnabled()) {
+            std::cout << "Streaming: " << streamer.getUnderruns() << " underruns, "
+                      << streamer.getSlotMisses() << " voices played resident part only (no free stream voice)" << std::endl;
+        }
+        
+        const auto& pool = audioEngine->getRenderPool();
+        if (pool.getTotalVoices() > 0) {
+            std::cout << "Parallel render: " << pool.getWorkerVoices() << " of " << pool.getTotalVoices()
+                      << " voice blocks on " << pool.getNumWorkers() << " workers" << std::endl;
+        }
+    }
+    
+    if (auto* alsa = audioEngine ? dynamic_cast<AlsaOutputDevice*>(audioEngine->getCurrentDevice()) : nullptr) {
+        std::cout << "ALSA: delay " << alsa->getMinDelayFrames() << "-" << alsa->getMaxDelayFrames()
+                  << " frames, underruns " << alsa->getXRunCount() << std::endl;
+    }
+    
+    if (midiInput) {
+        std::cout << "MIDI: sent " << midiInput->getNotesSent()
+                  << " notes, dropped " << midiInput->getDroppedEvents() << " events" << std::endl;
+    }
+    
+    if (sessionReplayer) {
+        std::cout << "Replay: sent " << sessionReplayer->getKeyDownsSent()
+                  << " key-downs, dropped " << sessionReplayer->getDroppedEvents() << " events" << std::endl;
+    }
+    
+    printLatencyReport();
+    
+    if (audioEngine) {
+        const auto& queue = audioEngine->getEventQueue();
+        std::cout << "Event queue: high-water " << queue.getHighWaterMark() << "/" << EventQueue::capacity
+                  << ", overflow " << queue.getOverflowCount() << std::endl;
+    }
+    
     std::cout << "✓ FXBoard shut down cleanly" << std::endl;
 }
 
@@ -121,6 +378,61 @@ void Application::loadConfiguration(const std::string& configPath) {
     }
 }
 
+void Application::setupRealtime() {
+    const juce::Identifier rt("Realtime");
+    realtimeConfig.enabled = configManager.getSectionProperty(rt, "enabled", false);
+    if (!realtimeConfig.enabled) {
+        return;
+    }
+    
+    realtimeConfig.inputPriority = configManager.getSectionProperty(rt, "inputPriority", realtimeConfig.inputPriority);
+    realtimeConfig.audioPriority = configManager.getSectionProperty(rt, "audioPriority", realtimeConfig.audioPriority);
+    realtimeConfig.inputCpu = configManager.getSectionProperty(rt, "inputCpu", realtimeConfig.inputCpu);
+    realtimeConfig.audioCpu = configManager.getSectionProperty(rt, "audioCpu", realtimeConfig.audioCpu);
+    realtimeConfig.renderCpu = configManager.getSectionProperty(rt, "renderCpu", realtimeConfig.renderCpu);
+    realtimeConfig.lockMemory = configManager.getSectionProperty(rt, "lockMemory", realtimeConfig.lockMemory);
+    realtimeConfig.cpuDmaLatencyUs = configManager.getSectionProperty(rt, "cpuDmaLatencyUs", realtimeConfig.cpuDmaLatencyUs);
+    
+    // Lock before samples are loaded so MCL_FUTURE covers them too
+    if (realtimeConfig.lockMemory && Realtime::lockMemory()) {
+        std::cout << "✓ Memory locked (mlockall)" << std::endl;
+    }
+    
+    if (realtimeConfig.cpuDmaLatencyUs >= 0 && cpuDmaLatency.acquire(realtimeConfig.cpuDmaLatencyUs)) {
+        std::cout << "✓ Deep C-states blocked (/dev/cpu_dma_latency)" << std::endl;
+    }
+    
+    std::cout << "✓ Real-time mode: input SCHED_FIFO " << realtimeConfig.inputPriority
+              << ", audio SCHED_FIFO " << realtimeConfig.audioPriority << std::endl;
+}
+
+void Application::configureEngine() {
+    // Settings shared by real-time and offline render mode (applied before the device starts)
+    audioEngine->setSchedulingDelayMs(configManager.getSectionProperty("Audio", "schedulingDelayMs", -1.0));
+    audioEngine->setMaxVoices(configManager.getSectionProperty("Audio", "maxVoices", 16));
+    audioEngine->setMaxVoicesPerSample(configManager.getSectionProperty("Audio", "maxVoicesPerSample", 4));
+    audioEngine->setParallelRendering(configManager.getSectionProperty("Audio", "renderThreads", 0),
+                                      configManager.getSectionProperty("Audio", "parallelMinVoices", 24),
+                                      realtimeConfig.enabled ? realtimeConfig.renderCpu : -1);
+    
+    auto interpolation = RenderKernels::Interpolation::Cubic;
+    juce::String interpolationName = configManager.getSectionProperty("Audio", "interpolation", "cubic").toString();
+    if (!RenderKernels::parseInterpolation(interpolationName.toRawUTF8(), interpolation)) {
+        std::cerr << "Warning: unknown audio.interpolation '" << interpolationName << "', using cubic" << std::endl;
+    }
+    audioEngine->setInterpolation(interpolation);
+    audioEngine->getSampleManager().setHugePages(configManager.getSectionProperty("Audio", "sampleHugePages", false));
+    
+    juce::String formatName = configManager.getSectionProperty("Audio", "sampleFormat", "float").toString();
+    auto format = SampleFormat::Float32;
+    if (formatName == "int16") {
+        format = SampleFormat::Int16;
+    } else if (formatName != "float") {
+        std::cerr << "Warning: unknown audio.sampleFormat '" << formatName << "', using float" << std::endl;
+    }
+    audioEngine->getSampleManager().setSampleFormat(format);
+}
+
 void Application::loadSamples() {
     // Try multiple sample directories
     std::vector<std::string> sampleDirs = {
@@ -144,20 +456,184 @@ void Application::loadSamples() {
         return;
     }
     
-    std::cout << "Loading samples from: " << samplesDir.getFullPathName() << std::endl;
-    
-    int loadedCount = 0;
+    auto& sampleManager = audioEngine->getSampleManager();
+    std::vector<juce::File> wavFiles;
     for (auto& file : samplesDir.findChildFiles(juce::File::findFiles, false, "*.wav")) {
-        juce::String sampleId = file.getFileNameWithoutExtension();
-        if (audioEngine->getSampleManager().loadSample(sampleId, file)) {
-            std::cout << "  ✓ Loaded: " << sampleId << std::endl;
-            loadedCount++;
-        } else {
-            std::cout << "  ✗ Failed: " << sampleId << std::endl;
+        wavFiles.push_back(file);
+    }
+    
+    // Precompiled bank: mapped in place when it matches the WAV files and audio.sampleRate
+    const juce::String bankPath = configManager.getSectionProperty("Audio", "sampleBank", "samples.fxbank").toString();
+    sampleBankFile = bankPath.isNotEmpty() ? samplesDir.getChildFile(bankPath) : juce::File();
+    sampleSourceHash = SampleBank::hashSources(wavFiles, sampleManager.getTargetSampleRate());
+    setupStreaming(samplesDir);
+    
+    if (!compileBankRequested && bankPath.isNotEmpty() && sampleManager.loadBank(sampleBankFile, sampleSourceHash)) {
+        std::cout << "✓ Mapped " << sampleManager.getNumSamples() << " samples from "
+                  << sampleBankFile.getFullPathName() << std::endl;
+        reportStreaming();
+        return;
+    }
+    
+    if (!compileBankRequested && bankPath.isNotEmpty() && sampleBankFile.existsAsFile()) {
+        std::cout << "⚠ Sample bank not usable, decoding WAV files (rebuild with --compile-bank)" << std::endl;
+    }
+    
+    // Decode on worker threads; returns at once, finishSampleLoading()/pollSampleLoading() complete it
+    std::vector<std::pair<juce::String, juce::File>> files;
+    for (auto& file : wavFiles) {
+        files.emplace_back(file.getFileNameWithoutExtension(), file);
+    }
+    sampleLoadStartMs = juce::Time::getMillisecondCounterHiRes() - startupStartMs;
+    sampleManager.loadSamplesAsync(files, configManager.getSectionProperty("Audio", "loadThreads", 0));
+    std::cout << "Loading samples from: " << samplesDir.getFullPathName() << " (" << files.size() << " files, "
+              << sampleManager.getLoadStats().numThreads << " threads)" << std::endl;
+}
+
+void Application::setupStreaming(const juce::File& samplesDir) {
+    // Real-time mode only: offline render and bank compile keep every sample resident
+    if (!renderEventsPath.empty() || compileBankRequested) {
+        return;
+    }
+    
+    // Per-sample override: "samples": { "ambience": { "streamThresholdMs": 2000 } } (0 = never stream)
+    auto& sampleManager = audioEngine->getSampleManager();
+    auto sampleSettings = configManager.getValueTree().getChildWithName("Samples");
+    for (int i = 0; i < sampleSettings.getNumProperties(); ++i) {
+        auto name = sampleSettings.getPropertyName(i);
+        auto settings = sampleSettings.getProperty(name);
+        if (settings.hasProperty("streamThresholdMs")) {
+            sampleManager.setSampleStreamThreshold(name.toString(), settings.getProperty("streamThresholdMs", 0.0));
+        }
+    }
+    
+    // Decoded tails go next to the samples rather than /tmp, which is often RAM-backed
+    const juce::File spillDir = samplesDir.hasWriteAccess() ? samplesDir
+                                                            : juce::File::getSpecialLocation(juce::File::tempDirectory);
+    const double thresholdMs = configManager.getSectionProperty("Audio", "streamThresholdMs", 0.0);
+    const double headMs = configManager.getSectionProperty("Audio", "streamHeadMs", 500.0);
+    if (sampleManager.setStreaming(thresholdMs, headMs, configManager.getSectionProperty("Audio", "streamVoices", 16),
+                                   spillDir.getChildFile(".fxboard-stream.pcm"))) {
+        std::cout << "Streaming samples longer than " << juce::String(thresholdMs, 0) << " ms (" << juce::String(headMs, 0)
+                  << " ms resident, " << sampleManager.getStreamer().getNumSlots() << " stream voices)" << std::endl;
+    }
+}
+
+void Application::reportStreaming() {
+    const auto& sampleManager = audioEngine->getSampleManager();
+    const auto& streamer = sampleManager.getStreamer();
+    if (!streamer.isEnabled()) {
+        return;
+    }
+    
+    // Resident cost is the voice buffers, whatever the size of the streamed samples
+    std::cout << "✓ Streaming " << sampleManager.getNumStreamedSamples() << " samples: "
+              << juce::String(static_cast<double>(sampleManager.getStreamedBytes()) / (1024.0 * 1024.0), 1)
+              << " MB left on disk, " << juce::String(static_cast<double>(streamer.getRingBytes()) / (1024.0 * 1024.0), 1)
+              << " MB of stream buffers" << std::endl;
+}
+
+void Application::applySampleSettings() {
+    // Per-sample settings: "samples": { "hihat": { "gain": 0.8, "maxVoices": 2 } }
+    auto sampleSettings = configManager.getValueTree().getChildWithName("Samples");
+    for (int i = 0; i < sampleSettings.getNumProperties(); ++i) {
+        auto name = sampleSettings.getPropertyName(i);
+        auto settings = sampleSettings.getProperty(name);
+        if (settings.hasProperty("gain")) {
+            audioEngine->getSampleManager().setSampleGain(name.toString(), static_cast<float>(settings.getProperty("gain", 1.0)));
+        }
+        if (settings.hasProperty("maxVoices")) {
+            audioEngine->getSampleManager().setSampleMaxVoices(name.toString(), settings.getProperty("maxVoices", 0));
+        }
+        if (settings.hasProperty("pitchRandom")) {
+            audioEngine->getSampleManager().setSamplePitchRandom(name.toString(),
+                                                                 static_cast<float>(settings.getProperty("pitchRandom", 0.0)));
+        }
+    }
+}
+
+void Application::waitForMappedSamples() {
+    auto& sampleManager = audioEngine->getSampleManager();
+    if (!sampleManager.isLoading()) {
+        return;
+    }
+    
+    juce::StringArray ids;
+    for (const auto& [scancode, sampleId] : audioEngine->getKeyMappings()) {
+        ids.addIfNotAlreadyThere(sampleId);
+    }
+    // MIDI pads are mapped later in setupMidi(), from the same config section
+    if (configManager.getSectionProperty("Midi", "enabled", false)) {
+        auto mappings = configManager.getValueTree().getChildWithName("MidiMapping");
+        for (int i = 0; i < mappings.getNumProperties(); ++i) {
+            auto value = mappings.getProperty(mappings.getPropertyName(i));
+            if (value.isString()) {
+                ids.addIfNotAlreadyThere(value.toString());
+            }
         }
     }
     
-    std::cout << "✓ Loaded " << loadedCount << " samples" << std::endl;
+    sampleManager.waitForSamples(ids);
+    std::cout << "✓ Mapped samples ready, decoding the rest in the background" << std::endl;
+}
+
+void Application::finishSampleLoading() {
+    auto& sampleManager = audioEngine->getSampleManager();
+    if (!sampleManager.isLoading()) {
+        return;
+    }
+    
+    sampleManager.finishLoading();
+    reportSampleLoad();
+    
+    // One locked, pre-faulted block for all PCM so the first hit after idle does not page-fault
+    if (const auto* arena = sampleManager.getArena()) {
+        std::cout << "✓ Sample memory: " << juce::String(static_cast<double>(arena->getSize()) / (1024.0 * 1024.0), 1)
+                  << " MB" << (arena->isLocked() ? ", locked" : ", NOT locked (see memlock limit)")
+                  << (arena->usesHugePages() ? ", huge pages" : "") << std::endl;
+    }
+}
+
+void Application::pollSampleLoading() {
+    // Everything decoded and handed to the audio thread: pack into the arena in the background
+    if (audioEngine->getSampleManager().pollLoading()) {
+        reportSampleLoad();
+    }
+}
+
+void Application::reportSampleLoad() {
+    const auto& stats = audioEngine->getSampleManager().getLoadStats();
+    for (const auto& id : stats.failed) {
+        std::cout << "  ✗ Failed: " << id << std::endl;
+    }
+    std::cout << "✓ Loaded " << stats.numFiles - stats.failed.size() << " samples in "
+              << juce::String(stats.wallMs, 1) << " ms" << std::endl;
+    
+    if (verbose) {
+        std::cout << "  all samples decoded at " << juce::String(sampleLoadStartMs + stats.wallMs, 1) << " ms: "
+                  << stats.numFiles << " files on " << stats.numThreads << " threads, "
+                  << juce::String(stats.decodeMs, 1) << " ms of decoding ("
+                  << juce::String(stats.decodeMs / juce::jmax(0.001, stats.wallMs), 1) << "x parallel)" << std::endl;
+    }
+    reportStreaming();
+}
+
+void Application::markStartup(const char* phase) {
+    startupPhases.emplace_back(phase, juce::Time::getMillisecondCounterHiRes() - startupStartMs);
+}
+
+void Application::printStartupTiming() {
+    std::cout << "\n=== Startup timing (ms) ===" << std::endl;
+    std::cout << "  phase                         at    took" << std::endl;
+    double previous = 0.0;
+    for (const auto& [phase, at] : startupPhases) {
+        std::cout << "  " << juce::String(phase).paddedRight(' ', 24) << juce::String(at, 1).paddedLeft(' ', 8)
+                  << juce::String(at - previous, 1).paddedLeft(' ', 8) << std::endl;
+        previous = at;
+    }
+    if (audioEngine && audioEngine->getSampleManager().isLoading()) {
+        std::cout << "  (remaining samples are still decoding in the background)" << std::endl;
+    }
 }
 
 void Application::setupKeyMappings() {
@@ -180,9 +656,141 @@ void Application::setupKeyMappings() {
         audioEngine->mapKeyToSample(scancode, sampleId);
     }
     
+    // Per-key tuning in semitones: "keytuning": { "36": -5, "midi:60": 2 }
+    auto tuning = configManager.getValueTree().getChildWithName("KeyTuning");
+    for (int i = 0; i < tuning.getNumProperties(); ++i) {
+        auto name = tuning.getPropertyName(i).toString();
+        const float semitones = static_cast<float>(static_cast<double>(tuning.getProperty(name)));
+        if (name.startsWith("midi:")) {
+            audioEngine->setKeyTuning(KeyEvent::MIDI_NOTE_BASE + static_cast<uint32_t>(name.substring(5).getIntValue()), semitones);
+        } else {
+            audioEngine->setKeyTuning(static_cast<uint32_t>(name.getIntValue()), semitones);
+        }
+    }
+    
     std::cout << "✓ Key mappings configured" << std::endl;
 }
 
+void Application::setupMidi() {
+    const juce::Identifier midi("Midi");
+    if (!configManager.getSectionProperty(midi, "enabled", false)) {
+        return;
+    }
+    
+    midiInput = std::make_unique<MidiInput>(audioEngine->getEventQueue());
+    midiInput->setChannel(configManager.getSectionProperty(midi, "channel", -1));
+    if (realtimeConfig.enabled) {
+        midiInput->setRealtime(realtimeConfig.inputPriority, realtimeConfig.inputCpu);
+    }
+    if (sessionRecorder) {
+        midiInput->setRecorder(sessionRecorder.get());
+    }
+    
+    // "36": "kick" plays a sample on its own key, "38": 31 plays whatever keyboard key 31 plays
+    int numMapped = 0;
+    auto mappings = configManager.getValueTree().getChildWithName("MidiMapping");
+    for (int i = 0; i < mappings.getNumProperties(); ++i) {
+        auto name = mappings.getPropertyName(i);
+        int note = name.toString().getIntValue();
+        auto value = mappings.getProperty(name);
+        
+        if (value.isString()) {
+            midiInput->mapNote(note);
+            audioEngine->mapKeyToSample(KeyEvent::MIDI_NOTE_BASE + static_cast<uint32_t>(note), value.toString());
+        } else {
+            midiInput->mapNote(note, static_cast<uint32_t>(static_cast<int>(value)));
+        }
+        ++numMapped;
+    }
+    
+    juce::String device = configManager.getSectionProperty(midi, "device", "hw:1,0,0").toString();
+    if (!midiInput->start(device)) {
+        std::cerr << "Warning: MIDI input failed to start (" << device << ")" << std::endl;
+        midiInput.reset();
+        return;
+    }
+    std::cout << "✓ MIDI input started: " << device << ", " << numMapped << " notes mapped"
+              << (midiInput->hasHardwareTimestamps() ? " (driver timestamps)" : "") << std::endl;
+}
+
+void Application::setupAdaptiveBuffer() {
+    adaptiveBuffer = configManager.getSectionProperty("Audio", "adaptiveBufferSize", false);
+    auto* device = audioEngine->getCurrentDevice();
+    if (!adaptiveBuffer || device == nullptr) {
+        adaptiveBuffer = false;
+        return;
+    }
+    
+    BufferSizeController::Config config;
+    config.minSize = configManager.getSectionProperty("Audio", "minBufferSize", config.minSize);
+    config.maxSize = configManager.getSectionProperty("Audio", "maxBufferSize", config.maxSize);
+    config.cleanSeconds = configManager.getSectionProperty("Audio", "adaptiveCleanSeconds", config.cleanSeconds);
+    config.xrunLimit = configManager.getSectionProperty("Audio", "adaptiveXrunLimit", config.xrunLimit);
+    config.xrunWindowSeconds = configManager.getSectionProperty("Audio", "adaptiveXrunWindowSeconds", config.xrunWindowSeconds);
+    
+    bufferController.reset(config, device->getCurrentBufferSizeSamples(),
+                           juce::Time::getMillisecondCounterHiRes() / 1000.0, getXRunTotal());
+    std::cout << "✓ Adaptive buffer size: " << config.minSize << "-" << config.maxSize << " samples" << std::endl;
+}
+
+int Application::getXRunTotal() const {
+    // Callback-gap and device counts can see the same underrun, so take the larger one
+    return std::max(audioEngine->getXRunCount(), audioEngine->getDeviceXRunCount());
+}
+
+void Application::updateAdaptiveBuffer() {
+    const double now = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+    const auto decision = bufferController.update(now, getXRunTotal());
+    if (decision.newSize == 0) {
+        return;
+    }
+    
+    const int oldSize = bufferController.getSize();
+    audioEngine->setBufferSize(decision.newSize);
+    
+    auto* device = audioEngine->getCurrentDevice();
+    const int actualSize = device != nullptr ? device->getCurrentBufferSizeSamples() : oldSize;
+    bufferController.applied(decision.newSize, actualSize, juce::Time::getMillisecondCounterHiRes() / 1000.0,
+                             getXRunTotal());
+    
+    if (decision.reason == BufferSizeController::Reason::XRuns) {
+        std::cout << "Buffer size " << oldSize << " -> " << actualSize << " samples ("
+                  << decision.recentXRuns << " xruns)" << std::endl;
+    } else {
+        std::cout << "Buffer size " << oldSize << " -> " << actualSize << " samples (no xruns for "
+                  << juce::String(decision.cleanFor, 0) << " s)" << std::endl;
+    }
+    if (actualSize != decision.newSize) {
+        std::cout << "  Device did not accept " << decision.newSize << " samples" << std::endl;
+    }
+}
+
+void Application::printLatencyReport() {
+    if (!audioEngine) {
+        return;
+    }
+    
+    static const std::pair<AudioEngine::LatencyStage, const char*> stages[] = {
+        {AudioEngine::LatencyInputToDequeue, "input → dequeue"},
+        {AudioEngine::LatencyDequeueToBlock, "dequeue → block"},
+        {AudioEngine::LatencyBlockOffset,    "block offset"},
+        {AudioEngine::LatencyDeviceOutput,   "device output"},
+        {AudioEngine::LatencyTotal,          "total"},
+    };
+    
+    std::cout << "\n=== Latency (ms) ===" << std::endl;
+    std::cout << "  stage              count     p50     p99   p99.9     max" << std::endl;
+    
+    auto ms = [](uint64_t us) { return juce::String(us / 1000.0, 2).paddedLeft(' ', 8); };
+    for (const auto& [stage, name] : stages) {
+        const auto& h = audioEngine->getLatencyHistogram(stage);
+        std::cout << "  " << juce::String(name).paddedRight(' ', 16)
+                  << juce::String(static_cast<juce::int64>(h.getCount())).paddedLeft(' ', 8)
+                  << ms(h.getPercentileUs(0.5)) << ms(h.getPercentileUs(0.99))
+                  << ms(h.getPercentileUs(0.999)) << ms(h.getMaxUs()) << std::endl;
+    }
+}
+
 void Application::printStatus() {
     std::cout << "\n=== Status ===" << std::endl;
     
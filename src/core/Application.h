@@ -1,10 +1,17 @@
 #pragma once
 
 #include "../audio/AudioEngine.h"
+#include "../audio/BufferSizeController.h"
 #include "../input/KeyHook.h"
+#include "../input/MidiInput.h"
+#include "../input/SessionRecorder.h"
+#include "../input/SessionReplayer.h"
 #include "../app/ConfigManager.h"
+#include "Realtime.h"
 #include <memory>
 #include <atomic>
+#include <utility>
+#include <vector>
 
 namespace FXBoard {
 
@@ -24,13 +31,59 @@ public:
      */
     bool initialize(const std::string& configPath = "");
 
+    /**
+     * Record live input to a session file (call before initialize)
+     */
+    void setRecordSession(const std::string& path) { recordPath = path; }
+    
+    /**
+     * Replay a recorded session into the audio engine (call before initialize)
+     * The application exits when the replay finishes
+     * @param speed Playback speed (1.0 = original timing)
+     */
+    void setReplaySession(const std::string& path, double speed) { replayPath = path; replaySpeed = speed; }
+
+    /**
+     * Offline render mode (call before initialize)
+     * No audio device or keyboard is opened; events come from a script or session file
+     */
+    void setOfflineRender(const std::string& eventsPath, const std::string& outputPath) {
+        renderEventsPath = eventsPath;
+        renderOutputPath = outputPath;
+    }
+    
+    /**
+     * Render the events to a WAV file and report the speed (after initialize, instead of run)
+     * @return true if rendering succeeded
+     */
+    bool renderOffline();
+    
+    /**
+     * Sample bank compile mode (call before initialize)
+     * Samples are decoded from WAV at audio.sampleRate, no audio device is opened
+     */
+    void setCompileBank() { compileBankRequested = true; }
+    
+    /**
+     * Print a startup timing breakdown and sample decode statistics (call before initialize)
+     */
+    void setVerbose(bool enabled) { verbose = enabled; }
+    
+    /**
+     * Write the loaded samples to the audio.sampleBank file (after initialize, instead of run)
+     * @return true if the bank was written
+     */
+    bool compileSampleBank();
+
     /**
      * Run the application (blocking until shutdown)
      */
     void run();
 
     /**
-     * Shutdown the application
+     * Shutdown the application: stop input, recorder and audio, join the log thread and print statistics
+     * Runs once after any initialize() call (also when it failed or running was already cleared);
+     * the destructor calls it too
      */
     void shutdown();
 
@@ -43,18 +96,65 @@ public:
      * Request shutdown (can be called from signal handler)
      */
     void requestShutdown() { running.store(false); }
+    
+    /**
+     * Request a latency report on the next main loop tick (safe from signal handler)
+     */
+    void requestLatencyReport() { latencyReportRequested.store(true); }
+    
+    /**
+     * Print key-to-audio latency percentiles
+     */
+    void printLatencyReport();
 
 private:
     void loadConfiguration(const std::string& configPath);
+    void setupRealtime();
+    void configureEngine();
     void loadSamples();
+    void setupStreaming(const juce::File& samplesDir);
+    void reportStreaming();
+    void applySampleSettings();
+    void waitForMappedSamples();
+    void finishSampleLoading();
+    void pollSampleLoading();
+    void reportSampleLoad();
     void setupKeyMappings();
+    void setupMidi();
+    void setupAdaptiveBuffer();
+    void updateAdaptiveBuffer();
+    int getXRunTotal() const;
     void printStatus();
+    void markStartup(const char* phase);
+    void printStartupTiming();
 
+    // Declared before the inputs that write into it, so it is destroyed after them
     std::unique_ptr<AudioEngine> audioEngine;
+    std::unique_ptr<SessionRecorder> sessionRecorder;
     std::unique_ptr<KeyHook> keyHook;
+    std::unique_ptr<MidiInput> midiInput;
+    std::unique_ptr<SessionReplayer> sessionReplayer;
     ConfigManager configManager;
+    RealtimeConfig realtimeConfig;
+    Realtime::CpuDmaLatencyGuard cpuDmaLatency;
+    BufferSizeController bufferController;
+    bool adaptiveBuffer = false;
+    std::string recordPath;
+    std::string replayPath;
+    double replaySpeed = 1.0;
+    std::string renderEventsPath;
+    std::string renderOutputPath;
+    bool compileBankRequested = false;
+    juce::File sampleBankFile;      // resolved audio.sampleBank (empty = disabled)
+    uint64_t sampleSourceHash = 0;  // SampleBank::hashSources() of the WAV files
+    bool verbose = false;
+    double startupStartMs = 0.0;
+    double sampleLoadStartMs = 0.0;  // ms after startupStartMs
+    std::vector<std::pair<const char*, double>> startupPhases;  // phase, ms after startupStartMs
 
+    bool initialized = false;  // initialize() has started and shutdown() has not run yet
     std::atomic<bool> running;
+    std::atomic<bool> latencyReportRequested{false};
 };
 
 } // namespace FXBoard
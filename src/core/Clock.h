@@ -0,0 +1,19 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+namespace FXBoard {
+
+/**
+ * 단조 시계 (CLOCK_MONOTONIC 기준 나노초)
+ * evdev 커널 타임스탬프(EVIOCSCLOCKID)와 같은 시간축
+ * vDSO 호출이므로 오디오 스레드에서도 안전
+ */
+inline uint64_t monotonicNowNs() {
+    // steady_clock == CLOCK_MONOTONIC (libstdc++/libc++ on Linux)
+    auto now = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count());
+}
+
+} // namespace FXBoard
@@ -3,56 +3,161 @@
 #include <array>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 namespace FXBoard {
 
 /**
  * 락프리 Multi-Producer Single-Consumer 이벤트 큐
- * 키보드 입력 스레드에서 오디오 스레드로 이벤트 전달
+ * 입력 스레드들(키보드, MIDI 등)에서 오디오 스레드로 이벤트 전달
+ *
+ * 슬롯별 시퀀스 번호를 쓰는 유계 링 (D. Vyukov 방식)
+ * - 프로듀서는 enqueuePos CAS로 위치를 예약하고 슬롯 시퀀스로 공개
+ * - 컨슈머는 오디오 스레드 하나뿐이므로 CAS 없이 순서대로 소비
+ *
+ * @tparam Capacity 슬롯 수 (2의 거듭제곱)
  */
-class EventQueue {
+template <size_t Capacity = 1024>
+class BasicEventQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "EventQueue capacity must be a power of two");
+
 public:
-    EventQueue() : tail(0), head(0) {}
-    
+    static constexpr size_t capacity = Capacity;
+
+    BasicEventQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
     /**
-     * 이벤트를 큐에 추가 (프로듀서)
-     * @return 성공 시 true, 큐가 가득 차면 false
+     * 이벤트를 큐에 추가 (프로듀서, 여러 스레드에서 동시 호출 가능)
+     * @return 성공 시 true, 큐가 가득 차면 false (오버플로 카운트 증가)
      */
     bool push(const KeyEvent& e) {
-        auto next = (head + 1) & mask;
-        if (next == tail.load(std::memory_order_acquire)) {
-            return false; // 큐 가득 참
+        return pushBatch(&e, 1);
+    }
+
+    /**
+     * 이벤트 묶음을 한 번에 추가 (프로듀서)
+     * 연속된 위치를 한 번에 예약하고 뒤에서부터 공개하므로
+     * 컨슈머는 묶음 전체를 보거나 전혀 보지 못함 (코드 동시 입력용)
+     * @return 성공 시 true, 공간이 부족하면 false (아무것도 추가하지 않음)
+     */
+    bool pushBatch(const KeyEvent* events, size_t count) {
+        if (count == 0) return true;
+        if (count > Capacity) {
+            overflowCount.fetch_add(count, std::memory_order_relaxed);
+            return false;
+        }
+
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            // 컨슈머는 순서대로 슬롯을 비우므로 묶음의 마지막 슬롯이 비었으면 앞 슬롯도 모두 비어 있음
+            size_t lastPos = pos + count - 1;
+            size_t seq = slots[lastPos & mask].sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(lastPos);
+
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                overflowCount.fetch_add(count, std::memory_order_relaxed);
+                return false; // 큐 가득 참
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed); // 다른 프로듀서가 먼저 예약
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            slots[(pos + i) & mask].event = events[i];
+        }
+        // 뒤에서부터 공개: 컨슈머가 첫 슬롯을 보는 순간 나머지도 준비된 상태
+        for (size_t i = count; i-- > 0; ) {
+            slots[(pos + i) & mask].sequence.store(pos + i + 1, std::memory_order_release);
+        }
+
+        // 다른 프로듀서의 뒤 묶음까지 이미 꺼냈으면 dequeuePos가 앞설 수 있음 (음수면 건너뜀)
+        const auto used = static_cast<intptr_t>(pos + count) -
+                          static_cast<intptr_t>(dequeuePos.load(std::memory_order_relaxed));
+        if (used > 0) {
+            updateHighWaterMark(static_cast<size_t>(used));
         }
-        buffer[head] = e;
-        head = next;
         return true;
     }
-    
+
     /**
      * 이벤트를 큐에서 제거 (컨슈머)
      * @return 성공 시 true, 큐가 비어있으면 false
      */
     bool pop(KeyEvent& out) {
-        auto t = tail.load(std::memory_order_acquire);
-        if (t == head) {
-            return false; // 큐 비어있음
+        return popBulk(&out, 1) == 1;
+    }
+
+    /**
+     * 준비된 이벤트를 최대 maxCount개까지 한 번에 제거 (컨슈머)
+     * @return 꺼낸 이벤트 수
+     */
+    size_t popBulk(KeyEvent* out, size_t maxCount) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        size_t n = 0;
+
+        while (n < maxCount) {
+            auto& slot = slots[pos & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+                break; // 비어 있거나 아직 쓰는 중
+            }
+            out[n++] = slot.event;
+            slot.sequence.store(pos + Capacity, std::memory_order_release);
+            ++pos;
         }
-        out = buffer[t];
-        tail.store((t + 1) & mask, std::memory_order_release);
-        return true;
+
+        dequeuePos.store(pos, std::memory_order_relaxed);
+        return n;
     }
-    
+
+    /**
+     * 컨슈머 관점에서 비어 있는지 확인
+     */
     bool isEmpty() const {
-        return tail.load(std::memory_order_acquire) == head;
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        return slots[pos & mask].sequence.load(std::memory_order_acquire) != pos + 1;
     }
-    
+
+    /**
+     * 통계
+     * overflow = 큐가 가득 차서 버려진 이벤트 수
+     * highWaterMark = 관측된 최대 점유 슬롯 수
+     */
+    uint64_t getOverflowCount() const { return overflowCount.load(std::memory_order_relaxed); }
+    size_t getHighWaterMark() const { return highWaterMark.load(std::memory_order_relaxed); }
+
 private:
-    static constexpr size_t capacity = 1024;
-    static constexpr size_t mask = capacity - 1;
-    
-    std::array<KeyEvent, capacity> buffer{};
-    std::atomic<size_t> tail;
-    size_t head;
+    static constexpr size_t mask = Capacity - 1;
+    static constexpr size_t cacheLineSize = 64;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        KeyEvent event;
+    };
+
+    void updateHighWaterMark(size_t used) {
+        size_t current = highWaterMark.load(std::memory_order_relaxed);
+        while (used > current &&
+               !highWaterMark.compare_exchange_weak(current, used, std::memory_order_relaxed)) {
+        }
+    }
+
+    // 프로듀서/컨슈머 인덱스와 통계가 서로 다른 캐시 라인을 쓰도록 분리
+    alignas(cacheLineSize) std::atomic<size_t> enqueuePos{0};
+    alignas(cacheLineSize) std::atomic<size_t> dequeuePos{0};
+    alignas(cacheLineSize) std::atomic<uint64_t> overflowCount{0};
+    std::atomic<size_t> highWaterMark{0};
+    alignas(cacheLineSize) std::array<Slot, Capacity> slots;
 };
 
+using EventQueue = BasicEventQueue<>;
+
 } // namespace FXBoard
@@ -4,6 +4,9 @@
 namespace FXBoard {
 
 struct KeyEvent {
+    /** MIDI 노트는 키보드 스캔코드(0-255) 뒤의 키 번호로 전달: MIDI_NOTE_BASE + note */
+    static constexpr uint32_t MIDI_NOTE_BASE = 256;
+    
     enum Type {
         Down,
         Up
@@ -11,10 +14,12 @@ struct KeyEvent {
     
     uint32_t scancode;
     uint64_t timestampNs;
+    uint8_t deviceIndex;  // 입력 디바이스 슬롯 (디바이스별 매핑용)
+    uint8_t velocity;     // 1-127 (키보드는 항상 127, MIDI는 note-on 벨로시티)
     
-    KeyEvent() : type(Down), scancode(0), timestampNs(0) {}
-    KeyEvent(Type t, uint32_t sc, uint64_t ts) 
-        : type(t), scancode(sc), timestampNs(ts) {}
+    KeyEvent() : type(Down), scancode(0), timestampNs(0), deviceIndex(0), velocity(127) {}
+    KeyEvent(Type t, uint32_t sc, uint64_t ts, uint8_t dev = 0, uint8_t vel = 127) 
+        : type(t), scancode(sc), timestampNs(ts), deviceIndex(dev), velocity(vel) {}
 };
 
 } // namespace FXBoard
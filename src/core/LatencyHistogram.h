@@ -0,0 +1,108 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace FXBoard {
+
+/**
+ * 고정 버킷 지연 히스토그램 (마이크로초 단위)
+ * 로그-선형 버킷: 2의 거듭제곱 구간마다 16개 하위 버킷 (상대 오차 < 6.25%)
+ *
+ * 기록은 오디오 스레드 하나에서만 (할당/락 없음)
+ * 읽기(백분위수)는 다른 스레드에서 언제든 가능 - 근사 스냅샷
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAJOR_BUCKETS = 24;  // 최대 약 2^(MAJOR_BUCKETS + SUB_BUCKET_BITS) us = 2^28 us (약 268초), 그 이상은 마지막 버킷
+    static constexpr int NUM_BUCKETS = (MAJOR_BUCKETS + 1) * SUB_BUCKETS;
+    
+    /**
+     * 값 기록 (단일 라이터)
+     */
+    void record(uint64_t valueUs) {
+        auto& bucket = buckets[static_cast<size_t>(bucketIndex(valueUs))];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (valueUs > maxValue.load(std::memory_order_relaxed)) {
+            maxValue.store(valueUs, std::memory_order_relaxed);
+        }
+    }
+    
+    /**
+     * 초기화 (라이터가 멈춰 있을 때만 호출)
+     */
+    void reset() {
+        for (auto& bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count.store(0, std::memory_order_relaxed);
+        maxValue.store(0, std::memory_order_relaxed);
+    }
+    
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    uint64_t getMaxUs() const { return maxValue.load(std::memory_order_relaxed); }
+    
+    /**
+     * 백분위수 (버킷 상한, 최댓값으로 제한)
+     * @param fraction 0..1 (예: 0.99)
+     */
+    uint64_t getPercentileUs(double fraction) const {
+        uint64_t total = 0;
+        for (const auto& bucket : buckets) {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        if (total == 0) return 0;
+        
+        auto target = static_cast<uint64_t>(fraction * static_cast<double>(total) + 0.5);
+        if (target < 1) target = 1;
+        
+        uint64_t cumulative = 0;
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            cumulative += buckets[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+            if (cumulative >= target) {
+                uint64_t upper = bucketLowerBound(i) + bucketWidth(i) - 1;
+                uint64_t maxUs = getMaxUs();
+                return upper < maxUs ? upper : maxUs;
+            }
+        }
+        return getMaxUs();
+    }
+    
+private:
+    static int bucketIndex(uint64_t v) {
+        if (v < static_cast<uint64_t>(SUB_BUCKETS)) {
+            return static_cast<int>(v);
+        }
+#if defined(__GNUC__) || defined(__clang__)
+        int msb = 63 - __builtin_clzll(v);
+#else
+        int msb = 0;
+        while ((v >> (msb + 1)) != 0) ++msb;
+#endif
+        int shift = msb - SUB_BUCKET_BITS;
+        int index = (shift + 1) * SUB_BUCKETS + static_cast<int>((v >> shift) - SUB_BUCKETS);
+        return index < NUM_BUCKETS ? index : NUM_BUCKETS - 1;
+    }
+    
+    static uint64_t bucketLowerBound(int index) {
+        if (index < SUB_BUCKETS) {
+            return static_cast<uint64_t>(index);
+        }
+        int shift = index / SUB_BUCKETS - 1;
+        return static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    }
+    
+    static uint64_t bucketWidth(int index) {
+        return index < SUB_BUCKETS ? 1 : (uint64_t{1} << (index / SUB_BUCKETS - 1));
+    }
+    
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> maxValue{0};
+};
+
+} // namespace FXBoard
@@ -0,0 +1,133 @@
+#include "OfflineRenderer.h"
+#include "../input/SessionFile.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace FXBoard {
+
+OfflineRenderer::OfflineRenderer(AudioEngine& engine) : audioEngine(engine) {
+}
+
+bool OfflineRenderer::loadEvents(const juce::File& file) {
+    juce::String error;
+    bool ok = file.hasFileExtension("fxsession")
+        ? SessionFile::load(file, events, error)
+        : loadScript(file, events, error);
+    
+    if (!ok) {
+        std::cerr << "Error: Cannot load events from " << file.getFullPathName() << ": " << error << std::endl;
+        events.clear();
+        return false;
+    }
+    
+    std::cout << "✓ Loaded " << events.size() << " events from " << file.getFileName() << std::endl;
+    return true;
+}
+
+bool OfflineRenderer::loadScript(const juce::File& file, std::vector<KeyEvent>& events, juce::String& error) {
+    if (!file.existsAsFile()) {
+        error = "file not found";
+        return false;
+    }
+    
+    constexpr uint64_t TAP_LENGTH_NS = 20000000;
+    juce::StringArray lines;
+    file.readLines(lines);
+    events.clear();
+    
+    for (int i = 0; i < lines.size(); ++i) {
+        auto line = lines[i].upToFirstOccurrenceOf("#", false, false).trim();
+        if (line.isEmpty()) continue;
+        
+        juce::StringArray tokens;
+        tokens.addTokens(line, " \t", "");
+        tokens.removeEmptyStrings();
+        
+        if (tokens.size() != 3 || !tokens[2].containsOnly("0123456789")) {
+            error = "line " + juce::String(i + 1) + ": expected '<time_ms> <down|up|tap> <scancode>'";
+            return false;
+        }
+        
+        auto timeNs = static_cast<uint64_t>(tokens[0].getDoubleValue() * 1.0e6);
+        auto scancode = static_cast<uint32_t>(tokens[2].getIntValue());
+        const auto& action = tokens[1];
+        
+        if (action == "down" || action == "tap") {
+            events.emplace_back(KeyEvent::Down, scancode, timeNs);
+        }
+        if (action == "up") {
+            events.emplace_back(KeyEvent::Up, scancode, timeNs);
+        } else if (action == "tap") {
+            events.emplace_back(KeyEvent::Up, scancode, timeNs + TAP_LENGTH_NS);
+        } else if (action != "down") {
+            error = "line " + juce::String(i + 1) + ": unknown action '" + action + "'";
+            return false;
+        }
+    }
+    
+    // tap의 up 이벤트가 다음 줄보다 늦을 수 있으므로 시각순 정렬 (같은 시각은 원래 순서 유지)
+    std::stable_sort(events.begin(), events.end(),
+                     [](const KeyEvent& a, const KeyEvent& b) { return a.timestampNs < b.timestampNs; });
+    return true;
+}
+
+bool OfflineRenderer::render(const juce::File& outputFile, double sampleRate, int blockSize, double tailSeconds) {
+    outputFile.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(outputFile);
+    if (stream->failedToOpen()) {
+        std::cerr << "Error: Cannot write " << outputFile.getFullPathName() << std::endl;
+        return false;
+    }
+    
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wavFormat.createWriterFor(stream.get(), sampleRate, 2, 24, {}, 0));
+    if (writer == nullptr) {
+        std::cerr << "Error: Cannot create WAV writer for " << outputFile.getFullPathName() << std::endl;
+        return false;
+    }
+    stream.release();  // writer owns the stream
+    
+    audioEngine.prepareOffline(sampleRate, blockSize);
+    
+    // Virtual clock starts at 1 s so that no event sits exactly on time zero
+    constexpr uint64_t TIMELINE_START_NS = 1000000000ULL;
+    const double lastEventSeconds = events.empty() ? 0.0 : events.back().timestampNs / 1.0e9;
+    const auto totalSamples = static_cast<juce::int64>((lastEventSeconds + tailSeconds) * sampleRate);
+    
+    juce::AudioBuffer<float> block(2, blockSize);
+    auto& queue = audioEngine.getEventQueue();
+    size_t nextEvent = 0;
+    peakLevel = 0.0f;
+    processingSeconds = 0.0;
+    
+    for (juce::int64 position = 0; position < totalSamples; position += blockSize) {
+        const auto blockStartNs = TIMELINE_START_NS + static_cast<uint64_t>(position * 1.0e9 / sampleRate);
+        const int numSamples = static_cast<int>(std::min<juce::int64>(blockSize, totalSamples - position));
+        
+        // Everything that "happened" before this callback is in the queue, as with live input
+        while (nextEvent < events.size() && TIMELINE_START_NS + events[nextEvent].timestampNs <= blockStartNs) {
+            KeyEvent event = events[nextEvent];
+            event.timestampNs += TIMELINE_START_NS;
+            if (!queue.push(event)) {
+                break;  // queue full - remaining events go in with the next block
+            }
+            ++nextEvent;
+        }
+        
+        // Only engine time counts towards the realtime factor (not WAV encoding)
+        auto start = std::chrono::steady_clock::now();
+        audioEngine.renderOffline(block.getArrayOfWritePointers(), 2, numSamples, blockStartNs);
+        processingSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        peakLevel = std::max(peakLevel, block.getMagnitude(0, numSamples));
+        writer->writeFromAudioSampleBuffer(block, 0, numSamples);
+    }
+    
+    renderedSeconds = static_cast<double>(totalSamples) / sampleRate;
+    return true;
+}
+
+} // namespace FXBoard
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../audio/AudioEngine.h"
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace FXBoard {
+
+/**
+ * Offline (faster than real time) renderer
+ * Drives the audio engine block by block on a virtual clock, without an audio device,
+ * and writes the result to a WAV file. Used for headless benchmarks and CI.
+ */
+class OfflineRenderer {
+public:
+    explicit OfflineRenderer(AudioEngine& engine);
+
+    /**
+     * Load input events
+     * .fxsession files are recorded sessions; anything else is a text event script:
+     *   # time_ms  action  scancode
+     *   0      down  30
+     *   120    up    30
+     *   250    tap   31     (down, then up 20 ms later)
+     */
+    bool loadEvents(const juce::File& file);
+
+    /**
+     * Render all events plus a tail to a 24-bit stereo WAV file
+     * @param tailSeconds Audio rendered after the last event (lets voices and reverb finish)
+     */
+    bool render(const juce::File& outputFile, double sampleRate, int blockSize, double tailSeconds = 1.0);
+
+    /**
+     * Results of the last render
+     */
+    double getRenderedSeconds() const { return renderedSeconds; }
+    double getProcessingSeconds() const { return processingSeconds; }
+    double getRealtimeFactor() const {
+        return processingSeconds > 0.0 ? renderedSeconds / processingSeconds : 0.0;
+    }
+    float getPeakLevel() const { return peakLevel; }
+    size_t getNumEvents() const { return events.size(); }
+
+private:
+    static bool loadScript(const juce::File& file, std::vector<KeyEvent>& events, juce::String& error);
+
+    AudioEngine& audioEngine;
+    std::vector<KeyEvent> events;  // timestampNs relative to the start, ascending
+
+    double renderedSeconds = 0.0;
+    double processingSeconds = 0.0;
+    float peakLevel = 0.0f;
+};
+
+} // namespace FXBoard
@@ -0,0 +1,123 @@
+#include "Realtime.h"
+#include <juce_core/juce_core.h>
+#include <cstring>
+
+#if JUCE_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <alloca.h>
+#endif
+
+namespace FXBoard {
+namespace Realtime {
+
+#if JUCE_LINUX
+
+bool configureCurrentThread(int priority, int cpu, const char* threadName) {
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (err != 0) {
+            juce::Logger::writeToLog(juce::String("Warning: failed to pin ") + threadName +
+                                     " thread to CPU " + juce::String(cpu) + ": " + strerror(err));
+        }
+    }
+    
+    prefaultStack();
+    
+    struct sched_param param {};
+    param.sched_priority = juce::jlimit(sched_get_priority_min(SCHED_FIFO),
+                                        sched_get_priority_max(SCHED_FIFO), priority);
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err != 0) {
+        // rtprio 권한 없음 - SCHED_OTHER로 계속
+        juce::Logger::writeToLog(juce::String("Warning: SCHED_FIFO not permitted for ") + threadName +
+                                 " thread (" + strerror(err) + "), staying at SCHED_OTHER");
+        juce::Logger::writeToLog("  Grant rtprio, e.g. '@audio - rtprio 95' in /etc/security/limits.conf");
+        return false;
+    }
+    
+    juce::Logger::writeToLog(juce::String(threadName) + " thread: SCHED_FIFO priority " +
+                             juce::String(param.sched_priority) +
+                             (cpu >= 0 ? ", CPU " + juce::String(cpu) : juce::String()));
+    return true;
+}
+
+void prefaultStack(size_t bytes) {
+    // 스택에 버퍼를 잡고 페이지마다 써서 미리 매핑 (mlockall 이후 잠긴 상태로 유지)
+    auto* stack = static_cast<volatile char*>(alloca(bytes));
+    for (size_t i = 0; i < bytes; i += 4096) {
+        stack[i] = 0;
+    }
+}
+
+bool lockMemory() {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        juce::Logger::writeToLog(juce::String("Warning: mlockall failed (") + strerror(errno) +
+                                 "), memory may be paged out");
+        juce::Logger::writeToLog("  Raise memlock, e.g. '@audio - memlock unlimited' in /etc/security/limits.conf");
+        return false;
+    }
+    return true;
+}
+
+bool CpuDmaLatencyGuard::acquire(int latencyUs) {
+    release();
+    
+    fd = open("/dev/cpu_dma_latency", O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        juce::Logger::writeToLog(juce::String("Warning: cannot open /dev/cpu_dma_latency (") +
+                                 strerror(errno) + "), deep C-states stay enabled");
+        return false;
+    }
+    
+    int32_t value = latencyUs;
+    if (write(fd, &value, sizeof(value)) != sizeof(value)) {
+        juce::Logger::writeToLog("Warning: failed to write /dev/cpu_dma_latency");
+        release();
+        return false;
+    }
+    
+    juce::Logger::writeToLog("CPU DMA latency limited to " + juce::String(latencyUs) + " us");
+    return true;
+}
+
+void CpuDmaLatencyGuard::release() {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+#else
+
+// 다른 플랫폼 - 아직 미구현 (일반 스케줄링)
+bool configureCurrentThread(int, int, const char* threadName) {
+    juce::Logger::writeToLog(juce::String("Realtime scheduling not implemented for this platform (") +
+                             threadName + ")");
+    return false;
+}
+
+void prefaultStack(size_t) {
+}
+
+bool lockMemory() {
+    return false;
+}
+
+bool CpuDmaLatencyGuard::acquire(int) {
+    return false;
+}
+
+void CpuDmaLatencyGuard::release() {
+}
+
+#endif
+
+} // namespace Realtime
+} // namespace FXBoard
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+
+namespace FXBoard {
+
+/**
+ * 실시간 스케줄링 설정
+ * config.json의 "realtime" 섹션
+ */
+struct RealtimeConfig {
+    bool enabled = false;
+    int inputPriority = 85;     // SCHED_FIFO 우선순위 (입력 스레드)
+    int audioPriority = 80;     // SCHED_FIFO 우선순위 (오디오 콜백 스레드)
+    int inputCpu = -1;          // 고정할 코어 (-1 = 고정 안 함)
+    int audioCpu = -1;
+    int renderCpu = -1;         // 첫 렌더 워커 코어 (이후 워커는 다음 코어)
+    bool lockMemory = true;     // mlockall(MCL_CURRENT | MCL_FUTURE)
+    int cpuDmaLatencyUs = 0;    // /dev/cpu_dma_latency 요청값 (-1 = 사용 안 함)
+};
+
+/**
+ * 실시간 스레드/메모리 유틸리티
+ * 권한이 없으면 경고만 남기고 일반 스케줄링으로 계속 동작
+ */
+namespace Realtime {
+
+/**
+ * 현재 스레드를 SCHED_FIFO로 전환하고 (선택적으로) 코어에 고정
+ * 스택도 미리 페이지 폴트시켜 둠
+ * @param priority SCHED_FIFO 우선순위 (1-99)
+ * @param cpu 고정할 코어 (-1 = 고정 안 함)
+ * @param threadName 로그용 이름
+ * @return SCHED_FIFO 적용에 성공하면 true
+ */
+bool configureCurrentThread(int priority, int cpu, const char* threadName);
+
+/**
+ * 현재 스레드 스택을 미리 터치 (첫 사용 시 페이지 폴트 방지)
+ */
+void prefaultStack(size_t bytes = 256 * 1024);
+
+/**
+ * 프로세스 메모리 잠금 (스왑/페이지 아웃 방지)
+ */
+bool lockMemory();
+
+/**
+ * /dev/cpu_dma_latency를 열어 둔 동안 깊은 C-state 진입 차단
+ * 파일을 닫으면 커널이 요청을 자동으로 해제함
+ */
+class CpuDmaLatencyGuard {
+public:
+    CpuDmaLatencyGuard() = default;
+    ~CpuDmaLatencyGuard() { release(); }
+    
+    CpuDmaLatencyGuard(const CpuDmaLatencyGuard&) = delete;
+    CpuDmaLatencyGuard& operator=(const CpuDmaLatencyGuard&) = delete;
+    
+    bool acquire(int latencyUs);
+    void release();
+    bool isHeld() const { return fd >= 0; }
+    
+private:
+    int fd = -1;
+};
+
+} // namespace Realtime
+
+} // namespace FXBoard
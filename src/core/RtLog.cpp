@@ -0,0 +1,174 @@
+#include "RtLog.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace FXBoard {
+
+namespace {
+
+/**
+ * 스레드별 SPSC 링 (프로듀서 = 소유 스레드, 컨슈머 = 드레인 스레드)
+ */
+struct LogRing {
+    static constexpr size_t capacity = 1024;
+    static constexpr size_t mask = capacity - 1;
+    
+    std::array<LogRecord, capacity> records;
+    alignas(64) std::atomic<size_t> head{0};  // 프로듀서
+    alignas(64) std::atomic<size_t> tail{0};  // 컨슈머
+    std::atomic<bool> claimed{false};
+    std::atomic<bool> closing{false};         // 소유 스레드 종료 - 비우면 반환
+};
+
+constexpr int MAX_THREADS = 16;
+
+std::array<LogRing, MAX_THREADS> rings;
+std::atomic<uint64_t> droppedRecords{0};
+std::atomic<bool> draining{false};
+std::thread drainThread;
+
+LogRing* claimRing() {
+    for (auto& ring : rings) {
+        bool expected = false;
+        if (!ring.closing.load(std::memory_order_acquire) &&
+            ring.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            return &ring;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * 스레드 종료 시 링 반환 예약
+ */
+struct ThreadRing {
+    LogRing* ring = nullptr;
+    bool attempted = false;
+    
+    LogRing* get() {
+        if (!attempted) {
+            attempted = true;
+            ring = claimRing();
+        }
+        return ring;
+    }
+    
+    ~ThreadRing() {
+        if (ring != nullptr) {
+            ring->closing.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadRing threadRing;
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO";
+        case LogLevel::Warning: return "WARN";
+        case LogLevel::Error:   return "ERROR";
+    }
+    return "?";
+}
+
+juce::String formatRecord(const LogRecord& record) {
+    juce::String text = juce::String("[") + levelName(record.level) + "] ";
+    
+    int argIndex = 0;
+    for (const char* p = record.format; *p != '\0'; ++p) {
+        if (p[0] == '{' && p[1] == '}' && argIndex < record.numArgs) {
+            if (record.floatMask & (1u << argIndex)) {
+                text += juce::String(record.args[argIndex].d, 3);
+            } else {
+                text += juce::String(static_cast<long long>(record.args[argIndex].i));
+            }
+            ++argIndex;
+            ++p;
+        } else {
+            text += juce::String::charToString(*p);
+        }
+    }
+    return text;
+}
+
+void drainAll() {
+    for (auto& ring : rings) {
+        if (!ring.claimed.load(std::memory_order_acquire)) continue;
+        
+        auto t = ring.tail.load(std::memory_order_relaxed);
+        while (t != ring.head.load(std::memory_order_acquire)) {
+            juce::Logger::writeToLog(formatRecord(ring.records[t]));
+            t = (t + 1) & LogRing::mask;
+            ring.tail.store(t, std::memory_order_release);
+        }
+        
+        // 소유 스레드가 끝났고 비었으면 풀에 반환
+        if (ring.closing.load(std::memory_order_acquire) &&
+            ring.tail.load(std::memory_order_relaxed) == ring.head.load(std::memory_order_acquire)) {
+            ring.claimed.store(false, std::memory_order_release);
+            ring.closing.store(false, std::memory_order_release);
+        }
+    }
+}
+
+void drainLoop() {
+    uint64_t reportedDrops = 0;
+    while (draining.load(std::memory_order_acquire)) {
+        drainAll();
+        
+        auto drops = droppedRecords.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            juce::Logger::writeToLog("[WARN] RtLog dropped " + juce::String(static_cast<long long>(drops - reportedDrops)) +
+                                     " records (ring full)");
+            reportedDrops = drops;
+        }
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    drainAll();
+}
+
+} // namespace
+
+void RtLog::start() {
+    if (draining.exchange(true)) return;
+    drainThread = std::thread(drainLoop);
+}
+
+void RtLog::stop() {
+    if (!draining.exchange(false)) return;
+    if (drainThread.joinable()) {
+        drainThread.join();
+    }
+}
+
+bool RtLog::registerThread() {
+    return threadRing.get() != nullptr;
+}
+
+uint64_t RtLog::getDroppedRecords() {
+    return droppedRecords.load(std::memory_order_relaxed);
+}
+
+void RtLog::push(const LogRecord& record) {
+    LogRing* ring = threadRing.get();
+    if (ring == nullptr) {
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    auto h = ring->head.load(std::memory_order_relaxed);
+    auto next = (h + 1) & LogRing::mask;
+    if (next == ring->tail.load(std::memory_order_acquire)) {
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring->records[h] = record;
+    ring->head.store(next, std::memory_order_release);
+}
+
+} // namespace FXBoard
@@ -0,0 +1,120 @@
+#pragma once
+#include "Clock.h"
+#include <cstdint>
+#include <type_traits>
+
+// 컴파일 시점 최소 로그 레벨 (0=Debug, 1=Info, 2=Warning, 3=Error)
+// 이보다 낮은 레벨의 호출은 코드 자체가 생성되지 않음
+#ifndef FXBOARD_RTLOG_MIN_LEVEL
+#define FXBOARD_RTLOG_MIN_LEVEL 1
+#endif
+
+namespace FXBoard {
+
+enum class LogLevel : uint8_t {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3
+};
+
+/**
+ * 고정 크기 바이너리 로그 레코드
+ * 포맷 문자열은 정적 리터럴 포인터로만 저장 (포맷 ID 역할)
+ */
+struct LogRecord {
+    static constexpr int MAX_ARGS = 4;
+    
+    union Arg {
+        int64_t i;
+        double d;
+    };
+    
+    uint64_t timestampNs;
+    const char* format;   // "{}" 자리표시자를 쓰는 문자열 리터럴
+    Arg args[MAX_ARGS];
+    LogLevel level;
+    uint8_t numArgs;
+    uint8_t floatMask;    // 비트 i가 1이면 args[i]는 double
+};
+
+/**
+ * 실시간 안전 로거
+ * 오디오 콜백/입력 스레드에서 할당, 락, I/O 없이 기록
+ * - 스레드마다 SPSC 링 버퍼 하나 (정적 풀에서 할당)
+ * - 백그라운드 스레드가 링을 비우고 문자열로 포맷해 juce::Logger로 출력
+ * - 링이 가득 차면 레코드를 버리고 카운트
+ *
+ * 사용 예: RtLog::debug("Key down: {} (device {})", code, slot);
+ */
+class RtLog {
+public:
+    /**
+     * 드레인 스레드 시작/중지 (중지 시 남은 레코드 모두 출력)
+     */
+    static void start();
+    static void stop();
+    
+    /**
+     * 현재 스레드의 링을 미리 확보
+     * 실시간 스레드 시작 시 호출하면 첫 로그에서 TLS 초기화 비용이 없음
+     * @return 링 풀이 가득 차면 false (이 스레드의 로그는 버려짐)
+     */
+    static bool registerThread();
+    
+    /**
+     * 링이 가득 차서 버려진 레코드 수
+     */
+    static uint64_t getDroppedRecords();
+    
+    template <typename... Args>
+    static void debug(const char* format, Args... args) { log<LogLevel::Debug>(format, args...); }
+    
+    template <typename... Args>
+    static void info(const char* format, Args... args) { log<LogLevel::Info>(format, args...); }
+    
+    template <typename... Args>
+    static void warning(const char* format, Args... args) { log<LogLevel::Warning>(format, args...); }
+    
+    template <typename... Args>
+    static void error(const char* format, Args... args) { log<LogLevel::Error>(format, args...); }
+    
+    template <LogLevel Level, typename... Args>
+    static void log(const char* format, Args... args) {
+        if constexpr (static_cast<int>(Level) >= FXBOARD_RTLOG_MIN_LEVEL) {
+            static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "RtLog supports at most 4 arguments");
+            
+            LogRecord record;
+            record.timestampNs = monotonicNowNs();
+            record.format = format;
+            record.level = Level;
+            record.numArgs = static_cast<uint8_t>(sizeof...(Args));
+            record.floatMask = 0;
+            
+            int index = 0;
+            (packArg(record, index++, args), ...);
+            
+            push(record);
+        } else {
+            (void)format;
+            ((void)args, ...);
+        }
+    }
+    
+private:
+    template <typename T>
+    static void packArg(LogRecord& record, int index, T value) {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                      "RtLog arguments must be numeric (no strings on the real-time path)");
+        if constexpr (std::is_floating_point_v<T>) {
+            record.args[index].d = static_cast<double>(value);
+            record.floatMask = static_cast<uint8_t>(record.floatMask | (1u << index));
+        } else {
+            record.args[index].i = static_cast<int64_t>(value);
+        }
+    }
+    
+    static void push(const LogRecord& record);
+};
+
+} // namespace FXBoard
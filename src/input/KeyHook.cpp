@@ -1,10 +1,16 @@
 #include "KeyHook.h"
-#include <chrono>
+#include "../core/Clock.h"
+#include "../core/Realtime.h"
+#include "../core/RtLog.h"
+#include "SessionRecorder.h"
 #include <thread>
 
 #if JUCE_LINUX
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
 #include <linux/input.h>
 #include <dirent.h>
 #include <cstring>
@@ -14,11 +20,13 @@
 
 namespace FXBoard {
 
-KeyHook::KeyHook() : active(false) {
+KeyHook::KeyHook(EventQueue& sink) : eventQueue(sink), active(false) {
 #if JUCE_WINDOWS
     hookHandle = nullptr;
 #elif JUCE_LINUX
-    deviceFd = -1;
+    epollFd = -1;
+    wakeFd = -1;
+    inotifyFd = -1;
 #elif JUCE_MAC
     eventTap = nullptr;
 #endif
@@ -29,36 +37,200 @@ KeyHook::~KeyHook() {
 }
 
 uint64_t KeyHook::getCurrentTimestampNs() {
-    auto now = std::chrono::high_resolution_clock::now();
-    return static_cast<uint64_t>(now.time_since_epoch().count());
+    return monotonicNowNs();
 }
 
-void KeyHook::processKeyDown(uint32_t scancode) {
-    KeyEvent event(KeyEvent::Down, scancode, getCurrentTimestampNs());
-    eventQueue.push(event);
+void KeyHook::processKeyDown(uint32_t scancode, uint64_t timestampNs, uint8_t deviceIndex) {
+    KeyEvent event(KeyEvent::Down, scancode, timestampNs, deviceIndex);
+    if (recorder != nullptr) {
+        recorder->record(&event, 1);
+    }
+    if (eventQueue.push(event)) {
+        keyDownsSent.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
-void KeyHook::processKeyUp(uint32_t scancode) {
-    KeyEvent event(KeyEvent::Up, scancode, getCurrentTimestampNs());
-    eventQueue.push(event);
+void KeyHook::processKeyUp(uint32_t scancode, uint64_t timestampNs, uint8_t deviceIndex) {
+    KeyEvent event(KeyEvent::Up, scancode, timestampNs, deviceIndex);
+    if (recorder != nullptr) {
+        recorder->record(&event, 1);
+    }
+    if (!eventQueue.push(event)) {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 #if JUCE_LINUX
 
-// /dev/input에서 키보드 디바이스 찾기 (개선된 버전)
-int KeyHook::findKeyboardDevice() {
+// evdev 이벤트의 커널 타임스탬프 (EVIOCSCLOCKID 이후 CLOCK_MONOTONIC)
+static uint64_t eventTimestampNs(const struct input_event& ev) {
+#ifdef input_event_sec
+    return static_cast<uint64_t>(ev.input_event_sec) * 1000000000ULL +
+           static_cast<uint64_t>(ev.input_event_usec) * 1000ULL;
+#else
+    return static_cast<uint64_t>(ev.time.tv_sec) * 1000000000ULL +
+           static_cast<uint64_t>(ev.time.tv_usec) * 1000ULL;
+#endif
+}
+
+// epoll 태그: 0..MAX_DEVICES-1은 디바이스 슬롯
+static constexpr uint32_t WAKE_TAG = 0xFFFFFFFFu;
+static constexpr uint32_t INOTIFY_TAG = 0xFFFFFFFEu;
+
+// 디바이스가 얼마나 키보드에 가까운지 점수화 (0 이하면 키보드 아님)
+int KeyHook::scoreKeyboardDevice(int fd, const char* name) {
+    // Check if device supports keyboard events
+    unsigned long evbit[EV_MAX/sizeof(long)/8 + 1] = {0};
+    if (ioctl(fd, EVIOCGBIT(0, sizeof(evbit)), evbit) < 0) {
+        return 0;
+    }
+    
+    if (!(evbit[0] & (1 << EV_KEY))) {
+        return 0;
+    }
+    
+    // Check for actual keyboard keys (not just mouse buttons)
+    unsigned long keybit[KEY_MAX/sizeof(long)/8 + 1] = {0};
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keybit)), keybit) < 0) {
+        return 0;
+    }
+    
+    // Score the device based on how keyboard-like it is
+    int score = 0;
+    
+    // Check for common keyboard keys (using proper bit testing)
+    auto test_bit = [&](unsigned int bit) -> bool {
+        return !!(keybit[bit / (sizeof(long) * 8)] & (1UL << (bit % (sizeof(long) * 8))));
+    };
+    
+    if (test_bit(KEY_A)) score += 10;
+    if (test_bit(KEY_SPACE)) score += 10;
+    if (test_bit(KEY_ENTER)) score += 10;
+    if (test_bit(KEY_KP0)) score += 10;  // 숫자 키패드 단독 디바이스
+    
+    // Penalize devices with mouse-like names
+    juce::String deviceName(name);
+    if (deviceName.containsIgnoreCase("mouse") || deviceName.containsIgnoreCase("touchpad")) {
+        score -= 50;
+    }
+    // Prefer devices with keyboard-like names
+    if (deviceName.containsIgnoreCase("keyboard") || deviceName.containsIgnoreCase("kbd")) {
+        score += 20;
+    }
+    
+    return score;
+}
+
+// 키보드 디바이스를 열어 슬롯과 epoll에 등록
+bool KeyHook::openDevice(const char* path) {
+    for (const auto& dev : devices) {
+        if (dev.fd >= 0 && dev.path == path) {
+            return true;  // 이미 열려 있음
+        }
+    }
+    
+    int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        // Log permission errors for debugging
+        if (errno == EACCES || errno == EPERM) {
+            juce::Logger::writeToLog(juce::String("Permission denied for: ") + juce::String(path));
+        }
+        return false;
+    }
+    
+    // Get device name
+    char name[256] = "Unknown";
+    if (ioctl(fd, EVIOCGNAME(sizeof(name)), name) < 0) {
+        close(fd);
+        return false;
+    }
+    
+    int score = scoreKeyboardDevice(fd, name);
+    juce::Logger::writeToLog(juce::String("Checking input device: ") + juce::String(path) + 
+                             " - " + juce::String(name) + " (score " + juce::String(score) + ")");
+    if (score <= 0) {
+        close(fd);
+        return false;
+    }
+    
+    // 같은 이름의 디바이스가 쓰던 슬롯을 우선 재사용 (재연결 시 인덱스 유지)
+    int slot = -1;
+    for (int i = 0; i < MAX_DEVICES; ++i) {
+        if (devices[i].fd < 0 && devices[i].name == name) {
+            slot = i;
+            break;
+        }
+    }
+    for (int i = 0; slot < 0 && i < MAX_DEVICES; ++i) {
+        if (devices[i].fd < 0 && devices[i].name.empty()) {
+            slot = i;
+        }
+    }
+    for (int i = 0; slot < 0 && i < MAX_DEVICES; ++i) {
+        if (devices[i].fd < 0) {
+            slot = i;
+        }
+    }
+    if (slot < 0) {
+        juce::Logger::writeToLog("Too many input devices, ignoring: " + juce::String(path));
+        close(fd);
+        return false;
+    }
+    
+    // 커널 타임스탬프를 CLOCK_MONOTONIC으로 전환 (기본값은 CLOCK_REALTIME)
+#ifdef EVIOCSCLOCKID
+    int clockId = CLOCK_MONOTONIC;
+    if (ioctl(fd, EVIOCSCLOCKID, &clockId) < 0) {
+        juce::Logger::writeToLog("Warning: EVIOCSCLOCKID failed, input timestamps use CLOCK_REALTIME");
+    }
+#endif
+    
+    struct epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.u32 = static_cast<uint32_t>(slot);
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        close(fd);
+        return false;
+    }
+    
+    devices[slot].fd = fd;
+    devices[slot].path = path;
+    devices[slot].name = name;
+    numDevices.fetch_add(1);
+    
+    juce::Logger::writeToLog(juce::String("Keyboard device ") + juce::String(slot) + ": " +
+                             juce::String(path) + " - " + juce::String(name));
+    return true;
+}
+
+void KeyHook::closeDevice(int slot) {
+    auto& dev = devices[slot];
+    if (dev.fd < 0) return;
+    
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, dev.fd, nullptr);
+    close(dev.fd);
+    dev.fd = -1;
+    dev.frameSize = 0;
+    dev.dropping = false;
+    numDevices.fetch_sub(1);
+    // name은 남겨 두어 재연결 시 같은 슬롯을 받도록 함
+    
+    juce::Logger::writeToLog(juce::String("Keyboard device ") + juce::String(slot) + " removed: " +
+                             juce::String(dev.path.c_str()));
+}
+
+// /dev/input의 모든 키보드 디바이스 열기
+int KeyHook::scanDevices() {
     DIR* dir = opendir("/dev/input");
     if (!dir) {
         juce::Logger::writeToLog("Failed to open /dev/input directory");
         juce::Logger::writeToLog("You may need to run: sudo ./scripts/setup_permissions.sh");
-        return -1;
+        return 0;
     }
     
     struct dirent* entry;
-    int fd = -1;
-    int bestScore = 0;
-    
-    // Try to find the best keyboard device (prefer actual keyboards over mice, etc.)
     while ((entry = readdir(dir)) != nullptr) {
         if (strncmp(entry->d_name, "event", 5) != 0) {
             continue;
@@ -66,137 +238,191 @@ int KeyHook::findKeyboardDevice() {
         
         char path[256];
         snprintf(path, sizeof(path), "/dev/input/%s", entry->d_name);
-        
-        int testFd = open(path, O_RDONLY | O_NONBLOCK);
-        if (testFd < 0) {
-            // Log permission errors for debugging
-            if (errno == EACCES || errno == EPERM) {
-                juce::Logger::writeToLog(juce::String("Permission denied for: ") + juce::String(path));
+        openDevice(path);
+    }
+    
+    closedir(dir);
+    return numDevices.load();
+}
+
+// /dev/input 변경 처리 (핫플러그)
+void KeyHook::handleHotplug() {
+    alignas(struct inotify_event) char buf[4096];
+    
+    ssize_t len;
+    while ((len = read(inotifyFd, buf, sizeof(buf))) > 0) {
+        for (char* p = buf; p < buf + len; ) {
+            auto* ie = reinterpret_cast<struct inotify_event*>(p);
+            p += sizeof(struct inotify_event) + ie->len;
+            
+            if (ie->len == 0 || strncmp(ie->name, "event", 5) != 0) {
+                continue;
+            }
+            
+            char path[256];
+            snprintf(path, sizeof(path), "/dev/input/%s", ie->name);
+            
+            if (ie->mask & IN_DELETE) {
+                for (int i = 0; i < MAX_DEVICES; ++i) {
+                    if (devices[i].fd >= 0 && devices[i].path == path) {
+                        closeDevice(i);
+                    }
+                }
+            } else {
+                // IN_CREATE 직후에는 udev가 권한을 아직 안 줬을 수 있음 → IN_ATTRIB에서 재시도
+                openDevice(path);
             }
-            continue;
-        }
-        
-        // Get device name
-        char name[256] = "Unknown";
-        if (ioctl(testFd, EVIOCGNAME(sizeof(name)), name) < 0) {
-            close(testFd);
-            continue;
-        }
-        
-        juce::Logger::writeToLog(juce::String("Checking input device: ") + juce::String(path) + 
-                                 " - " + juce::String(name));
-        
-        // Check if device supports keyboard events
-        unsigned long evbit[EV_MAX/sizeof(long)/8 + 1] = {0};
-        if (ioctl(testFd, EVIOCGBIT(0, sizeof(evbit)), evbit) < 0) {
-            close(testFd);
-            continue;
-        }
-        
-        if (!(evbit[0] & (1 << EV_KEY))) {
-            close(testFd);
-            continue;
-        }
-        
-        // Check for actual keyboard keys (not just mouse buttons)
-        unsigned long keybit[KEY_MAX/sizeof(long)/8 + 1] = {0};
-        if (ioctl(testFd, EVIOCGBIT(EV_KEY, sizeof(keybit)), keybit) < 0) {
-            close(testFd);
-            continue;
-        }
-        
-        // Score the device based on how keyboard-like it is
-        int score = 0;
-        
-        // Check for common keyboard keys (using proper bit testing)
-        auto test_bit = [&](unsigned int bit) -> bool {
-            return !!(keybit[bit / (sizeof(long) * 8)] & (1UL << (bit % (sizeof(long) * 8))));
-        };
-        
-        if (test_bit(KEY_A)) score += 10;
-        if (test_bit(KEY_SPACE)) score += 10;
-        if (test_bit(KEY_ENTER)) score += 10;
-        
-        // Penalize devices with mouse-like names
-        juce::String deviceName(name);
-        if (deviceName.containsIgnoreCase("mouse") || deviceName.containsIgnoreCase("touchpad")) {
-            score -= 50;
         }
-        // Prefer devices with keyboard-like names
-        if (deviceName.containsIgnoreCase("keyboard") || deviceName.containsIgnoreCase("kbd")) {
-            score += 20;
+    }
+}
+
+// 프레임 안의 키 이벤트를 한 번에 큐에 공개 (동시 입력이 같은 오디오 블록에 도착)
+void KeyHook::publishFrame(InputDevice& dev) {
+    if (dev.frameSize == 0) return;
+    
+    if (recorder != nullptr) {
+        recorder->record(dev.frame.data(), static_cast<size_t>(dev.frameSize));
+    }
+    
+    if (eventQueue.pushBatch(dev.frame.data(), static_cast<size_t>(dev.frameSize))) {
+        for (int i = 0; i < dev.frameSize; ++i) {
+            if (dev.frame[i].type == KeyEvent::Down) {
+                keyDownsSent.fetch_add(1, std::memory_order_relaxed);
+            }
         }
-        
-        juce::Logger::writeToLog(juce::String("  Device score: ") + juce::String(score));
-        
-        if (score > bestScore) {
-            if (fd >= 0) {
-                close(fd);  // Close previous best
+    } else {
+        droppedEvents.fetch_add(static_cast<uint64_t>(dev.frameSize), std::memory_order_relaxed);
+    }
+    dev.frameSize = 0;
+}
+
+void KeyHook::handleInputEvent(int slot, const struct input_event& ev) {
+    auto& dev = devices[slot];
+    
+    if (ev.type == EV_SYN) {
+        if (ev.code == SYN_DROPPED) {
+            // 커널 버퍼 오버플로 - 다음 SYN_REPORT까지의 이벤트는 불완전하므로 폐기
+            dev.frameSize = 0;
+            dev.dropping = true;
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        } else if (ev.code == SYN_REPORT) {
+            if (dev.dropping) {
+                dev.dropping = false;
+                dev.frameSize = 0;
+            } else {
+                publishFrame(dev);
             }
-            fd = testFd;
-            bestScore = score;
-            juce::Logger::writeToLog(juce::String("  ^ New best keyboard device"));
-        } else {
-            close(testFd);
         }
+        return;
     }
     
-    closedir(dir);
+    // ev.value == 2는 key repeat (무시)
+    if (dev.dropping || ev.type != EV_KEY || ev.value == 2) return;
     
-    if (fd >= 0) {
-        juce::Logger::writeToLog("Successfully opened keyboard device");
-    } else {
-        juce::Logger::writeToLog("Failed to find suitable keyboard device");
-        juce::Logger::writeToLog("Make sure:");
-        juce::Logger::writeToLog("  1. Your user is in the 'input' group: groups | grep input");
-        juce::Logger::writeToLog("  2. udev rules are installed: ls /etc/udev/rules.d/99-fxboard.rules");
-        juce::Logger::writeToLog("  3. You've logged out and back in after adding to group");
-        juce::Logger::writeToLog("Run: sudo ./scripts/setup_permissions.sh");
+    if (dev.frameSize == MAX_FRAME_EVENTS) {
+        publishFrame(dev);  // 비정상적으로 큰 프레임 - 나눠서 공개
     }
     
-    return fd;
+    // ev.code는 이미 Linux 스캔코드 (evdev codes)
+    // 우리가 사용하는 스캔코드와 동일
+    auto type = (ev.value == 1) ? KeyEvent::Down : KeyEvent::Up;
+    dev.frame[dev.frameSize++] = KeyEvent(type, ev.code, eventTimestampNs(ev), static_cast<uint8_t>(slot));
+    
+    if (type == KeyEvent::Down) {
+        RtLog::debug("Key down: {} (device {})", ev.code, slot);
+    }
 }
 
 void KeyHook::runHookThread() {
-    struct input_event ev;
+    RtLog::registerThread();
+    if (rtPriority > 0) {
+        Realtime::configureCurrentThread(rtPriority, rtCpu, "Input");
+    }
+    
+    struct input_event events[64];
+    struct epoll_event ready[MAX_DEVICES + 2];
     
     while (active) {
-        ssize_t n = read(deviceFd, &ev, sizeof(ev));
+        // 입력이 도착할 때까지 블로킹 (폴링/슬립 없음)
+        int numReady = epoll_wait(epollFd, ready, MAX_DEVICES + 2, -1);
+        if (numReady < 0) {
+            if (errno == EINTR) continue;
+            juce::Logger::writeToLog("epoll_wait failed on input devices");
+            break;
+        }
         
-        if (n == sizeof(ev)) {
-            if (ev.type == EV_KEY) {
-                // ev.code는 이미 Linux 스캔코드 (evdev codes)
-                // 우리가 사용하는 스캔코드와 동일
-                if (ev.value == 1) {  // Key press
-                    processKeyDown(ev.code);
-                    juce::Logger::writeToLog(juce::String("Key down: ") + juce::String((int)ev.code));
-                } else if (ev.value == 0) {  // Key release
-                    processKeyUp(ev.code);
+        for (int i = 0; i < numReady; ++i) {
+            uint32_t tag = ready[i].data.u32;
+            if (tag == WAKE_TAG) {
+                continue;  // stop() 요청 - 루프 조건에서 종료
+            }
+            if (tag == INOTIFY_TAG) {
+                handleHotplug();
+                continue;
+            }
+            
+            int slot = static_cast<int>(tag);
+            int fd = devices[slot].fd;
+            if (fd < 0) continue;  // 같은 배치에서 이미 제거됨
+            
+            // 논블로킹 fd에서 대기 중인 이벤트를 배열 단위로 모두 읽음
+            ssize_t n;
+            while ((n = read(fd, events, sizeof(events))) > 0) {
+                size_t count = static_cast<size_t>(n) / sizeof(struct input_event);
+                for (size_t k = 0; k < count; ++k) {
+                    handleInputEvent(slot, events[k]);
                 }
-                // ev.value == 2는 key repeat (무시)
             }
-        } else if (n < 0 && errno != EAGAIN) {
-            juce::Logger::writeToLog("Error reading from input device");
-            break;
+            
+            // 언플러그(ENODEV) 등 - 해당 디바이스만 닫고 계속 동작
+            if ((n < 0 && errno != EAGAIN) || (ready[i].events & (EPOLLERR | EPOLLHUP))) {
+                closeDevice(slot);
+            }
         }
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
 }
 
 bool KeyHook::start() {
     if (active) return true;
     
-    // 키보드 디바이스 찾기
-    deviceFd = findKeyboardDevice();
+    // 모든 키보드 디바이스, 핫플러그 감시, 종료 신호를 하나의 epoll로 대기
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        juce::Logger::writeToLog("Failed to create epoll/eventfd for keyboard hook");
+        stop();
+        return false;
+    }
+    
+    struct epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.u32 = WAKE_TAG;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
     
-    if (deviceFd < 0) {
-        juce::Logger::writeToLog("Failed to find keyboard device. Try running with sudo or add user to 'input' group:");
-        juce::Logger::writeToLog("  sudo usermod -a -G input $USER");
-        juce::Logger::writeToLog("  (then logout and login again)");
+    // 디바이스 추가/제거 감시 (실패해도 핫플러그만 비활성화)
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd >= 0 &&
+        inotify_add_watch(inotifyFd, "/dev/input", IN_CREATE | IN_ATTRIB | IN_DELETE) >= 0) {
+        ev.data.u32 = INOTIFY_TAG;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, inotifyFd, &ev);
+    } else {
+        juce::Logger::writeToLog("Warning: inotify on /dev/input failed, device hotplug disabled");
+    }
+    
+    // 키보드 디바이스 찾기
+    if (scanDevices() == 0) {
+        juce::Logger::writeToLog("Failed to find suitable keyboard device");
+        juce::Logger::writeToLog("Make sure:");
+        juce::Logger::writeToLog("  1. Your user is in the 'input' group: groups | grep input");
+        juce::Logger::writeToLog("  2. udev rules are installed: ls /etc/udev/rules.d/99-fxboard.rules");
+        juce::Logger::writeToLog("  3. You've logged out and back in after adding to group");
+        juce::Logger::writeToLog("Run: sudo ./scripts/setup_permissions.sh");
+        stop();
         return false;
     }
     
+    juce::Logger::writeToLog("Opened " + juce::String(numDevices.load()) + " keyboard device(s)");
+    
     // 후킹 스레드 시작
     active = true;
     hookThread = std::make_unique<std::thread>(&KeyHook::runHookThread, this);
@@ -206,17 +432,35 @@ bool KeyHook::start() {
 }
 
 void KeyHook::stop() {
-    if (!active) return;
-    
-    active = false;
-    
-    if (hookThread && hookThread->joinable()) {
-        hookThread->join();
+    if (active) {
+        active = false;
+        
+        // epoll_wait에서 블로킹 중인 스레드 깨우기
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            juce::Logger::writeToLog("Failed to wake keyboard hook thread");
+        }
+        
+        if (hookThread && hookThread->joinable()) {
+            hookThread->join();
+        }
     }
     
-    if (deviceFd >= 0) {
-        close(deviceFd);
-        deviceFd = -1;
+    for (int i = 0; i < MAX_DEVICES; ++i) {
+        closeDevice(i);
+        devices[i].name.clear();
+    }
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+        inotifyFd = -1;
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+        wakeFd = -1;
     }
 }
 
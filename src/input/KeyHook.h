@@ -1,17 +1,33 @@
 #pragma once
 #include "../core/EventQueue.h"
 #include <juce_events/juce_events.h>
+#include <array>
+#include <atomic>
 #include <memory>
+#include <string>
+
+#if JUCE_LINUX
+struct input_event;
+#endif
 
 namespace FXBoard {
 
+class SessionRecorder;
+
 /**
  * 키보드 입력 후킹
  * 플랫폼별 저수준 키보드 입력 수집
  */
 class KeyHook {
 public:
-    KeyHook();
+    /** 동시에 캡처하는 최대 입력 디바이스 수 (KeyEvent::deviceIndex 범위) */
+    static constexpr int MAX_DEVICES = 16;
+    
+    /**
+     * @param sink 이벤트를 직접 넣을 큐 (AudioEngine::getEventQueue())
+     *             입력 스레드 → 오디오 스레드 한 번의 락프리 전달
+     */
+    explicit KeyHook(EventQueue& sink);
     ~KeyHook();
     
     /**
@@ -25,37 +41,100 @@ public:
     void stop();
     
     /**
-     * 이벤트 큐 반환
+     * 후킹 스레드 실시간 스케줄링 설정 (start() 전에 호출)
+     * @param priority SCHED_FIFO 우선순위 (0 = 일반 스케줄링)
+     * @param cpu 고정할 코어 (-1 = 고정 안 함)
+     */
+    void setRealtime(int priority, int cpu) { rtPriority = priority; rtCpu = cpu; }
+    
+    /**
+     * 입력 세션 녹음기 연결 (start() 전에 호출, nullptr = 녹음 안 함)
+     * 큐에 공개하는 프레임을 그대로 녹음기에도 전달
+     */
+    void setRecorder(SessionRecorder* sessionRecorder) { recorder = sessionRecorder; }
+    
+    /**
+     * 이벤트 싱크 반환
      */
     EventQueue& getEventQueue() { return eventQueue; }
     
+    /**
+     * 전달 통계 (AudioEngine::getKeyDownsProcessed()와 비교용)
+     */
+    uint64_t getKeyDownsSent() const { return keyDownsSent.load(std::memory_order_relaxed); }
+    uint64_t getDroppedEvents() const { return droppedEvents.load(std::memory_order_relaxed); }
+    
+    /**
+     * SYN_DROPPED(커널 버퍼 오버플로)로 폐기된 프레임 수
+     */
+    uint64_t getDroppedFrames() const { return droppedFrames.load(std::memory_order_relaxed); }
+    
     /**
      * 후킹 활성 상태 확인
      */
     bool isActive() const { return active; }
     
+    /**
+     * 현재 열려 있는 키보드 디바이스 수
+     */
+    int getNumDevices() const { return numDevices.load(); }
+    
 private:
-    EventQueue eventQueue;
+    EventQueue& eventQueue;
+    SessionRecorder* recorder = nullptr;
     bool active;
+    std::atomic<int> numDevices{0};
+    int rtPriority = 0;
+    int rtCpu = -1;
+    std::atomic<uint64_t> keyDownsSent{0};
+    std::atomic<uint64_t> droppedEvents{0};
+    std::atomic<uint64_t> droppedFrames{0};
     
     // 플랫폼별 구현
 #if JUCE_WINDOWS
     void* hookHandle;
     static LRESULT CALLBACK keyboardProc(int nCode, WPARAM wParam, LPARAM lParam);
 #elif JUCE_LINUX
-    int deviceFd;  // evdev file descriptor
+    static constexpr int MAX_FRAME_EVENTS = 32;  // SYN_REPORT 프레임당 최대 키 이벤트
+    
+    struct InputDevice {
+        int fd = -1;        // evdev file descriptor (-1 = 빈 슬롯)
+        std::string path;   // /dev/input/eventN
+        std::string name;   // EVIOCGNAME (재연결 시 같은 슬롯 재사용)
+        
+        // 현재 SYN_REPORT 프레임 (read 경계를 넘어 이어질 수 있음)
+        std::array<KeyEvent, MAX_FRAME_EVENTS> frame;
+        int frameSize = 0;
+        bool dropping = false;  // SYN_DROPPED 이후 다음 SYN_REPORT까지 폐기
+    };
+    
+    std::array<InputDevice, MAX_DEVICES> devices;  // 슬롯 인덱스 = deviceIndex
+    int epollFd;    // 디바이스/inotify/종료 신호를 함께 대기
+    int wakeFd;     // stop() 시 블로킹 대기를 깨우는 eventfd
+    int inotifyFd;  // /dev/input 핫플러그 감시
     std::unique_ptr<std::thread> hookThread;
     void runHookThread();
-    int findKeyboardDevice();
+    int scanDevices();
+    bool openDevice(const char* path);
+    void closeDevice(int slot);
+    void handleHotplug();
+    void handleInputEvent(int slot, const struct input_event& ev);
+    void publishFrame(InputDevice& dev);
+    static int scoreKeyboardDevice(int fd, const char* name);
 #elif JUCE_MAC
     void* eventTap;
     static CGEventRef eventCallback(CGEventTapProxy proxy, CGEventType type, 
                                     CGEventRef event, void* refcon);
 #endif
     
-    void processKeyDown(uint32_t scancode);
-    void processKeyUp(uint32_t scancode);
-    uint64_t getCurrentTimestampNs();
+    void processKeyDown(uint32_t scancode, uint64_t timestampNs, uint8_t deviceIndex = 0);
+    void processKeyUp(uint32_t scancode, uint64_t timestampNs, uint8_t deviceIndex = 0);
+    
+    /**
+     * 현재 시각 (CLOCK_MONOTONIC 기준 나노초)
+     * evdev 커널 타임스탬프와 같은 시간축
+     */
+    static uint64_t getCurrentTimestampNs();
 };
 
 } // namespace FXBoard
@@ -1,4 +1,5 @@
 #pragma once
+#include "../core/Clock.h"
 #include <cstdint>
 #include <chrono>
 
@@ -17,8 +18,8 @@ struct KeyState {
      */
     float getHoldTimeMs() const {
         if (!pressed) return 0.0f;
-        auto now = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::nanoseconds(now.time_since_epoch().count() - downTs);
+        // downTs는 CLOCK_MONOTONIC 기준 (evdev 커널 타임스탬프)
+        auto duration = std::chrono::nanoseconds(static_cast<int64_t>(monotonicNowNs() - downTs));
         return std::chrono::duration<float, std::milli>(duration).count();
     }
     
@@ -0,0 +1,283 @@
+#include "MidiInput.h"
+#include "../core/Clock.h"
+#include "../core/Realtime.h"
+#include "../core/RtLog.h"
+#include "SessionRecorder.h"
+
+#if JUCE_LINUX
+#include <alsa/asoundlib.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace FXBoard {
+
+MidiInput::MidiInput(EventQueue& sink) : eventQueue(sink) {
+    noteToKey.fill(-1);
+}
+
+MidiInput::~MidiInput() {
+    stop();
+}
+
+void MidiInput::mapNote(int note, uint32_t key) {
+    if (note >= 0 && note < 128) {
+        noteToKey[static_cast<size_t>(note)] = static_cast<int32_t>(key);
+    }
+}
+
+void MidiInput::unmapNote(int note) {
+    if (note >= 0 && note < 128) {
+        noteToKey[static_cast<size_t>(note)] = -1;
+    }
+}
+
+void MidiInput::parse(const uint8_t* bytes, size_t count, uint64_t timestampNs) {
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t b = bytes[i];
+        
+        if (b >= 0xF8) {
+            continue;  // 리얼타임 메시지 (클럭, active sensing) - running status 유지
+        }
+        
+        if (b & 0x80) {
+            dataCount = 0;
+            if (b == 0xF0) {
+                inSysex = true;
+                runningStatus = 0;
+            } else if (b >= 0xF1) {
+                inSysex = false;
+                runningStatus = 0;  // 시스템 공통 메시지 - 데이터 바이트는 무시
+            } else {
+                inSysex = false;
+                runningStatus = b;
+            }
+            continue;
+        }
+        
+        if (inSysex || runningStatus == 0) {
+            continue;
+        }
+        
+        messageData[static_cast<size_t>(dataCount++)] = b;
+        const uint8_t type = runningStatus & 0xF0;
+        const int needed = (type == 0xC0 || type == 0xD0) ? 1 : 2;
+        if (dataCount == needed) {
+            handleMessage(runningStatus, messageData[0], messageData[1], timestampNs);
+            dataCount = 0;
+        }
+    }
+}
+
+void MidiInput::handleMessage(uint8_t status, uint8_t data1, uint8_t data2, uint64_t timestampNs) {
+    const uint8_t type = status & 0xF0;
+    if (type != 0x90 && type != 0x80) return;
+    if (channel >= 0 && (status & 0x0F) != channel) return;
+    
+    const int32_t key = noteToKey[data1];
+    if (key < 0) return;
+    
+    // velocity 0인 note-on은 note-off
+    const bool down = (type == 0x90 && data2 > 0);
+    
+    if (frameSize == MAX_FRAME_EVENTS) {
+        publishFrame();
+    }
+    frame[frameSize++] = KeyEvent(down ? KeyEvent::Down : KeyEvent::Up, static_cast<uint32_t>(key),
+                                  timestampNs, DEVICE_INDEX, down ? data2 : uint8_t{127});
+    
+    if (down) {
+        RtLog::debug("MIDI note on: {} velocity {}", data1, data2);
+    }
+}
+
+void MidiInput::publishFrame() {
+    if (frameSize == 0) return;
+    
+    if (recorder != nullptr) {
+        recorder->record(frame.data(), frameSize);
+    }
+    
+    if (eventQueue.pushBatch(frame.data(), frameSize)) {
+        for (size_t i = 0; i < frameSize; ++i) {
+            if (frame[i].type == KeyEvent::Down) {
+                notesSent.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    } else {
+        droppedEvents.fetch_add(frameSize, std::memory_order_relaxed);
+    }
+    frameSize = 0;
+}
+
+#if JUCE_LINUX
+
+bool MidiInput::start(const juce::String& device) {
+    if (active) return true;
+    
+    runningStatus = 0;
+    dataCount = 0;
+    inSysex = false;
+    frameSize = 0;
+    hardwareTimestamps = false;
+    
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        juce::Logger::writeToLog("Failed to create eventfd for MIDI input");
+        return false;
+    }
+    
+    if (device.startsWithChar('/') || device.startsWithChar('.')) {
+        // 파일/FIFO 대체 입력 (테스트용, 타임스탬프 = read 시각)
+        fileFd = open(device.toRawUTF8(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fileFd < 0) {
+            juce::Logger::writeToLog("Cannot open MIDI input file " + device + ": " + juce::String(strerror(errno)));
+            stop();
+            return false;
+        }
+    } else {
+        int err = snd_rawmidi_open(&rawmidi, nullptr, device.toRawUTF8(), SND_RAWMIDI_NONBLOCK);
+        if (err < 0) {
+            juce::Logger::writeToLog("Cannot open MIDI device " + device + ": " + juce::String(snd_strerror(err)));
+            rawmidi = nullptr;
+            stop();
+            return false;
+        }
+        
+#if SND_LIB_VERSION >= 0x010206
+        // 드라이버 수신 시각 (evdev와 같은 CLOCK_MONOTONIC 시간축)
+        snd_rawmidi_params_t* params;
+        snd_rawmidi_params_alloca(&params);
+        if (snd_rawmidi_params_current(rawmidi, params) == 0 &&
+            snd_rawmidi_params_set_read_mode(rawmidi, params, SND_RAWMIDI_READ_TSTAMP) == 0 &&
+            snd_rawmidi_params_set_clock_type(rawmidi, params, SND_RAWMIDI_CLOCK_MONOTONIC) == 0 &&
+            snd_rawmidi_params(rawmidi, params) == 0) {
+            hardwareTimestamps = true;
+        }
+#endif
+    }
+    
+    juce::Logger::writeToLog("MIDI input opened: " + device +
+                             (hardwareTimestamps ? " (driver timestamps)" : " (read timestamps)"));
+    
+    active = true;
+    readThread = std::make_unique<std::thread>(&MidiInput::runReadThread, this);
+    return true;
+}
+
+void MidiInput::stop() {
+    if (active.exchange(false)) {
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            juce::Logger::writeToLog("Failed to wake MIDI input thread");
+        }
+    }
+    
+    if (readThread && readThread->joinable()) {
+        readThread->join();
+    }
+    readThread.reset();
+    
+    if (rawmidi != nullptr) {
+        snd_rawmidi_close(rawmidi);
+        rawmidi = nullptr;
+    }
+    if (fileFd >= 0) {
+        close(fileFd);
+        fileFd = -1;
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+        wakeFd = -1;
+    }
+}
+
+void MidiInput::runReadThread() {
+    RtLog::registerThread();
+    if (rtPriority > 0) {
+        Realtime::configureCurrentThread(rtPriority, rtCpu, "MIDI");
+    }
+    
+    constexpr int MAX_POLL_FDS = 8;
+    struct pollfd fds[MAX_POLL_FDS];
+    int numFds = 0;
+    
+    fds[numFds++] = { wakeFd, POLLIN, 0 };
+    if (rawmidi != nullptr) {
+        numFds += snd_rawmidi_poll_descriptors(rawmidi, fds + numFds, MAX_POLL_FDS - numFds);
+    } else {
+        fds[numFds++] = { fileFd, POLLIN, 0 };
+    }
+    
+    uint8_t buffer[256];
+    
+    while (active.load(std::memory_order_relaxed)) {
+        if (poll(fds, static_cast<nfds_t>(numFds), -1) < 0) {
+            if (errno == EINTR) continue;
+            RtLog::error("MIDI poll failed: {}", errno);
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            break;  // stop()
+        }
+        
+        // 쌓인 데이터를 모두 읽음 (read 한 번 = 같은 타임스탬프의 한 묶음)
+        for (;;) {
+            ssize_t n;
+            uint64_t timestampNs = 0;
+            
+            if (rawmidi != nullptr) {
+#if SND_LIB_VERSION >= 0x010206
+                if (hardwareTimestamps) {
+                    struct timespec tstamp {};
+                    n = snd_rawmidi_tread(rawmidi, &tstamp, buffer, sizeof(buffer));
+                    timestampNs = static_cast<uint64_t>(tstamp.tv_sec) * 1000000000ULL +
+                                  static_cast<uint64_t>(tstamp.tv_nsec);
+                } else
+#endif
+                {
+                    n = snd_rawmidi_read(rawmidi, buffer, sizeof(buffer));
+                }
+                if (n == -EAGAIN) break;
+                if (n < 0) {
+                    RtLog::error("MIDI read failed: {}", n);
+                    active = false;
+                    break;
+                }
+            } else {
+                n = read(fileFd, buffer, sizeof(buffer));
+                if (n < 0 && errno == EAGAIN) break;
+                if (n <= 0) {
+                    // 파일 끝 또는 FIFO 쓰는 쪽이 닫힘 - 더 이상 대기하지 않음
+                    RtLog::info("MIDI input file ended");
+                    fds[1].fd = -1;
+                    break;
+                }
+            }
+            
+            if (timestampNs == 0) {
+                timestampNs = monotonicNowNs();
+            }
+            parse(buffer, static_cast<size_t>(n), timestampNs);
+            publishFrame();
+        }
+    }
+}
+
+#else
+
+bool MidiInput::start(const juce::String& device) {
+    juce::Logger::writeToLog("MIDI input is only supported on Linux (ALSA): " + device);
+    return false;
+}
+
+void MidiInput::stop() {
+}
+
+#endif
+
+} // namespace FXBoard
@@ -0,0 +1,118 @@
+#pragma once
+#include "../core/EventQueue.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#if JUCE_LINUX
+typedef struct _snd_rawmidi snd_rawmidi_t;
+#endif
+
+namespace FXBoard {
+
+class SessionRecorder;
+
+/**
+ * MIDI 입력 (패드 컨트롤러 등)
+ * ALSA rawmidi 바이트를 파싱해 note-on/off를 KeyEvent로 바꾸고,
+ * 읽는 스레드에서 바로 이벤트 큐에 넣음 (KeyHook과 같은 한 번의 전달)
+ *
+ * 커널/alsa-lib가 지원하면 (Linux 5.14+, alsa-lib 1.2.6+) 드라이버가 바이트를 받은
+ * 시각을 CLOCK_MONOTONIC 타임스탬프로 사용, 아니면 read() 시각
+ */
+class MidiInput {
+public:
+    /** MIDI 이벤트의 KeyEvent::deviceIndex (키보드 슬롯 0-15 다음) */
+    static constexpr uint8_t DEVICE_INDEX = 16;
+    
+    /**
+     * @param sink 이벤트를 직접 넣을 큐 (AudioEngine::getEventQueue())
+     */
+    explicit MidiInput(EventQueue& sink);
+    ~MidiInput();
+    
+    /**
+     * 노트 매핑 (start() 전에 설정, 매핑되지 않은 노트는 무시)
+     * @param key 전달할 키 번호. 기본은 노트 전용 키 (KeyEvent::MIDI_NOTE_BASE + note),
+     *            키보드 스캔코드를 주면 그 키와 같은 샘플을 연주
+     */
+    void mapNote(int note, uint32_t key);
+    void mapNote(int note) { mapNote(note, KeyEvent::MIDI_NOTE_BASE + static_cast<uint32_t>(note)); }
+    void unmapNote(int note);
+    
+    /**
+     * 수신 채널 (0-15, -1 = 모든 채널)
+     */
+    void setChannel(int newChannel) { channel = newChannel; }
+    
+    /**
+     * 읽기 스레드 실시간 스케줄링 설정 (start() 전에 호출)
+     */
+    void setRealtime(int priority, int cpu) { rtPriority = priority; rtCpu = cpu; }
+    
+    /**
+     * 입력 세션 녹음기 연결 (start() 전에 호출)
+     */
+    void setRecorder(SessionRecorder* sessionRecorder) { recorder = sessionRecorder; }
+    
+    /**
+     * 입력 시작
+     * @param device ALSA rawmidi 이름 (예: "hw:1,0,0", snd-virmidi의 "hw:Virtual,0")
+     *               또는 원시 MIDI 바이트를 읽을 파일/FIFO 경로 ('/'나 '.'로 시작)
+     */
+    bool start(const juce::String& device);
+    void stop();
+    
+    bool isActive() const { return active.load(); }
+    
+    /**
+     * 드라이버 수신 타임스탬프 사용 여부 (false면 read() 시각)
+     */
+    bool hasHardwareTimestamps() const { return hardwareTimestamps; }
+    
+    /**
+     * 전달 통계
+     */
+    uint64_t getNotesSent() const { return notesSent.load(std::memory_order_relaxed); }
+    uint64_t getDroppedEvents() const { return droppedEvents.load(std::memory_order_relaxed); }
+    
+private:
+    static constexpr size_t MAX_FRAME_EVENTS = 32;
+    
+    EventQueue& eventQueue;
+    SessionRecorder* recorder = nullptr;
+    std::array<int32_t, 128> noteToKey;  // -1 = 매핑 없음
+    int channel = -1;
+    int rtPriority = 0;
+    int rtCpu = -1;
+    bool hardwareTimestamps = false;
+    std::atomic<bool> active{false};
+    std::atomic<uint64_t> notesSent{0};
+    std::atomic<uint64_t> droppedEvents{0};
+    
+    // MIDI 바이트 파서 (읽기 스레드 전용, running status 지원)
+    uint8_t runningStatus = 0;
+    std::array<uint8_t, 2> messageData {};
+    int dataCount = 0;
+    bool inSysex = false;
+    
+    // 한 번의 read에서 나온 노트 (같은 타임스탬프, 한 묶음으로 공개)
+    std::array<KeyEvent, MAX_FRAME_EVENTS> frame;
+    size_t frameSize = 0;
+    
+    void parse(const uint8_t* bytes, size_t count, uint64_t timestampNs);
+    void handleMessage(uint8_t status, uint8_t data1, uint8_t data2, uint64_t timestampNs);
+    void publishFrame();
+    
+#if JUCE_LINUX
+    snd_rawmidi_t* rawmidi = nullptr;
+    int fileFd = -1;   // 파일/FIFO 입력
+    int wakeFd = -1;   // stop() 시 poll 대기를 깨우는 eventfd
+    std::unique_ptr<std::thread> readThread;
+    void runReadThread();
+#endif
+};
+
+} // namespace FXBoard
@@ -0,0 +1,89 @@
+#pragma once
+#include "../core/KeyEvent.h"
+#include <juce_core/juce_core.h>
+#include <cstring>
+#include <vector>
+
+namespace FXBoard {
+
+/**
+ * 입력 세션 파일 (.fxsession)
+ *
+ * 헤더 16바이트: "FXSN", 버전(int32), 녹음 시작 시각(int64, Unix ms)
+ * 레코드 16바이트: 녹음 시작 기준 시각(int64 ns), 스캔코드(int32), 타입(int16),
+ *                 디바이스(하위 8비트) | 벨로시티(상위 8비트)(int16, 버전 1은 디바이스만 - 벨로시티 127)
+ * 모두 리틀 엔디언. 같은 디바이스/같은 시각의 연속 레코드가 하나의 SYN_REPORT 프레임
+ */
+namespace SessionFile {
+
+constexpr int VERSION = 2;
+constexpr int HEADER_SIZE = 16;
+constexpr int RECORD_SIZE = 16;
+
+inline bool writeHeader(juce::OutputStream& out) {
+    return out.write("FXSN", 4)
+        && out.writeInt(VERSION)
+        && out.writeInt64(juce::Time::currentTimeMillis());
+}
+
+/**
+ * @param startNs 녹음 시작 시각 (이벤트 시각에서 빼서 상대 시각으로 저장)
+ */
+inline bool writeEvent(juce::OutputStream& out, const KeyEvent& event, uint64_t startNs) {
+    auto offsetNs = event.timestampNs > startNs ? event.timestampNs - startNs : 0;
+    return out.writeInt64(static_cast<juce::int64>(offsetNs))
+        && out.writeInt(static_cast<int>(event.scancode))
+        && out.writeShort(static_cast<short>(event.type))
+        && out.writeShort(static_cast<short>((event.velocity << 8) | event.deviceIndex));
+}
+
+/**
+ * 세션 파일 전체 읽기
+ * @param events 읽은 이벤트 (timestampNs = 녹음 시작 기준 상대 시각, 오름차순)
+ * @return 성공 시 true, 실패 시 error에 이유
+ */
+inline bool load(const juce::File& file, std::vector<KeyEvent>& events, juce::String& error) {
+    juce::FileInputStream in(file);
+    if (in.failedToOpen()) {
+        error = "cannot open " + file.getFullPathName();
+        return false;
+    }
+    
+    char magic[4] = {};
+    if (in.read(magic, 4) != 4 || std::memcmp(magic, "FXSN", 4) != 0) {
+        error = "not an FXBoard session file";
+        return false;
+    }
+    const int version = in.readInt();
+    if (version < 1 || version > VERSION) {
+        error = "unsupported session file version";
+        return false;
+    }
+    in.readInt64();  // 녹음 시작 시각 (정보용)
+    
+    auto numRecords = (in.getTotalLength() - HEADER_SIZE) / RECORD_SIZE;
+    events.clear();
+    events.reserve(static_cast<size_t>(juce::jmax<juce::int64>(0, numRecords)));
+    
+    uint64_t lastNs = 0;
+    for (juce::int64 i = 0; i < numRecords; ++i) {
+        auto offsetNs = static_cast<uint64_t>(in.readInt64());
+        auto scancode = static_cast<uint32_t>(in.readInt());
+        auto type = in.readShort();
+        auto deviceAndVelocity = static_cast<uint16_t>(in.readShort());
+        auto device = static_cast<uint8_t>(deviceAndVelocity & 0xFF);
+        auto velocity = version >= 2 ? static_cast<uint8_t>(deviceAndVelocity >> 8) : uint8_t{127};
+        
+        if (type != KeyEvent::Down && type != KeyEvent::Up) {
+            error = "corrupt record " + juce::String(i);
+            return false;
+        }
+        // 디바이스 간 약간의 역전은 정렬된 시각으로 보정
+        lastNs = juce::jmax(lastNs, offsetNs);
+        events.emplace_back(static_cast<KeyEvent::Type>(type), scancode, lastNs, device, velocity);
+    }
+    return true;
+}
+
+} // namespace SessionFile
+} // namespace FXBoard
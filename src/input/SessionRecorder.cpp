@@ -0,0 +1,65 @@
+#include "SessionRecorder.h"
+#include "SessionFile.h"
+#include "../core/Clock.h"
+#include <array>
+#include <chrono>
+
+namespace FXBoard {
+
+SessionRecorder::~SessionRecorder() {
+    stop();
+}
+
+bool SessionRecorder::start(const juce::File& file) {
+    if (recording.load()) return false;
+    
+    file.deleteFile();
+    stream = std::make_unique<juce::FileOutputStream>(file);
+    if (stream->failedToOpen() || !SessionFile::writeHeader(*stream)) {
+        juce::Logger::writeToLog("Cannot write session file: " + file.getFullPathName());
+        stream.reset();
+        return false;
+    }
+    
+    startNs = monotonicNowNs();
+    recordedEvents = 0;
+    recording.store(true, std::memory_order_release);
+    writerThread = std::thread(&SessionRecorder::runWriterThread, this);
+    
+    juce::Logger::writeToLog("Recording input session to " + file.getFullPathName());
+    return true;
+}
+
+void SessionRecorder::stop() {
+    if (!recording.exchange(false)) return;
+    
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+    drain();
+    stream->flush();
+    stream.reset();
+    
+    juce::Logger::writeToLog("Session recording stopped: " + juce::String(static_cast<juce::int64>(getRecordedEvents()))
+                             + " events, " + juce::String(static_cast<juce::int64>(getDroppedEvents())) + " dropped");
+}
+
+void SessionRecorder::runWriterThread() {
+    while (recording.load(std::memory_order_acquire)) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+void SessionRecorder::drain() {
+    std::array<KeyEvent, 256> events;
+    size_t count;
+    while ((count = buffer.popBulk(events.data(), events.size())) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            SessionFile::writeEvent(*stream, events[i], startNs);
+        }
+        recordedEvents.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+} // namespace FXBoard
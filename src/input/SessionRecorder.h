@@ -0,0 +1,59 @@
+#pragma once
+#include "../core/EventQueue.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace FXBoard {
+
+/**
+ * 입력 세션 녹음기
+ * KeyHook이 큐에 공개한 프레임을 그대로 받아 세션 파일로 기록
+ * 입력 스레드는 락프리 큐에 복사만 하고, 파일 쓰기는 별도 스레드에서 처리
+ */
+class SessionRecorder {
+public:
+    SessionRecorder() = default;
+    ~SessionRecorder();
+    
+    /**
+     * 녹음 시작 (파일을 새로 만들고 헤더 기록)
+     */
+    bool start(const juce::File& file);
+    
+    /**
+     * 남은 이벤트를 모두 기록하고 파일 닫기
+     */
+    void stop();
+    
+    /**
+     * 프레임 기록 (입력 스레드, 블로킹/할당 없음)
+     * 버퍼가 가득 차면 프레임을 버리고 드롭 카운트 증가
+     */
+    void record(const KeyEvent* events, size_t count) {
+        if (!recording.load(std::memory_order_acquire)) return;
+        buffer.pushBatch(events, count);
+    }
+    
+    bool isRecording() const { return recording.load(); }
+    
+    /**
+     * 통계
+     */
+    uint64_t getRecordedEvents() const { return recordedEvents.load(std::memory_order_relaxed); }
+    uint64_t getDroppedEvents() const { return buffer.getOverflowCount(); }
+    
+private:
+    void runWriterThread();
+    void drain();
+    
+    BasicEventQueue<4096> buffer;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    std::thread writerThread;
+    std::atomic<bool> recording{false};
+    std::atomic<uint64_t> recordedEvents{0};
+    uint64_t startNs = 0;
+};
+
+} // namespace FXBoard
@@ -0,0 +1,97 @@
+#include "SessionReplayer.h"
+#include "SessionFile.h"
+#include "../core/Clock.h"
+#include "../core/Realtime.h"
+#include "../core/RtLog.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+namespace FXBoard {
+
+SessionReplayer::SessionReplayer(EventQueue& sink) : eventQueue(sink) {
+}
+
+SessionReplayer::~SessionReplayer() {
+    stop();
+}
+
+bool SessionReplayer::load(const juce::File& file) {
+    juce::String error;
+    if (!SessionFile::load(file, events, error)) {
+        juce::Logger::writeToLog("Cannot load session " + file.getFullPathName() + ": " + error);
+        events.clear();
+        return false;
+    }
+    
+    juce::Logger::writeToLog("Loaded session: " + juce::String(static_cast<int>(events.size())) + " events, "
+                             + juce::String(getDurationSeconds(), 1) + " s");
+    return true;
+}
+
+bool SessionReplayer::start() {
+    if (running.load() || events.empty()) return false;
+    
+    finished = false;
+    running = true;
+    replayThread = std::thread(&SessionReplayer::runReplayThread, this);
+    return true;
+}
+
+void SessionReplayer::stop() {
+    running = false;
+    if (replayThread.joinable()) {
+        replayThread.join();
+    }
+}
+
+void SessionReplayer::runReplayThread() {
+    RtLog::registerThread();
+    if (rtPriority > 0) {
+        Realtime::configureCurrentThread(rtPriority, rtCpu, "Replay");
+    }
+    
+    constexpr size_t MAX_FRAME_EVENTS = 32;
+    constexpr uint64_t MAX_SLEEP_NS = 10000000;  // stop() 응답성을 위해 10ms씩 나눠 대기
+    std::array<KeyEvent, MAX_FRAME_EVENTS> frame;
+    
+    const uint64_t baseNs = monotonicNowNs();
+    size_t index = 0;
+    
+    while (running.load(std::memory_order_relaxed) && index < events.size()) {
+        const auto& first = events[index];
+        const uint64_t targetNs = baseNs + static_cast<uint64_t>(static_cast<double>(first.timestampNs) / speed);
+        
+        // 재생 시각까지 대기
+        uint64_t now = monotonicNowNs();
+        while (now < targetNs && running.load(std::memory_order_relaxed)) {
+            uint64_t wakeNs = std::min(targetNs, now + MAX_SLEEP_NS);
+            std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(wakeNs)));
+            now = monotonicNowNs();
+        }
+        
+        // 같은 디바이스/같은 시각 = 원래 SYN_REPORT 프레임, 한 묶음으로 공개
+        size_t frameSize = 0;
+        while (index < events.size() && frameSize < MAX_FRAME_EVENTS
+               && events[index].timestampNs == first.timestampNs
+               && events[index].deviceIndex == first.deviceIndex) {
+            frame[frameSize] = events[index++];
+            frame[frameSize].timestampNs = targetNs;  // 커널 타임스탬프에 해당하는 시각
+            ++frameSize;
+        }
+        
+        if (eventQueue.pushBatch(frame.data(), frameSize)) {
+            for (size_t i = 0; i < frameSize; ++i) {
+                if (frame[i].type == KeyEvent::Down) {
+                    keyDownsSent.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        } else {
+            droppedEvents.fetch_add(frameSize, std::memory_order_relaxed);
+        }
+    }
+    
+    finished = (index == events.size());
+}
+
+} // namespace FXBoard
@@ -0,0 +1,76 @@
+#pragma once
+#include "../core/EventQueue.h"
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace FXBoard {
+
+/**
+ * 입력 세션 재생기
+ * 녹음된 세션을 원래 타이밍대로 (또는 배속으로) 라이브 입력과 같은 큐에 넣음
+ * 이벤트 타임스탬프는 재생 시각으로 다시 찍어 지연 측정이 라이브와 같은 의미를 갖도록 함
+ */
+class SessionReplayer {
+public:
+    /**
+     * @param sink 이벤트를 넣을 큐 (AudioEngine::getEventQueue())
+     */
+    explicit SessionReplayer(EventQueue& sink);
+    ~SessionReplayer();
+    
+    /**
+     * 세션 파일 로드 (start() 전에 호출)
+     */
+    bool load(const juce::File& file);
+    
+    /**
+     * 재생 속도 (1.0 = 원래 속도, 2.0 = 두 배속)
+     */
+    void setSpeed(double newSpeed) { speed = newSpeed > 0.0 ? newSpeed : 1.0; }
+    
+    /**
+     * 재생 스레드 실시간 스케줄링 (start() 전에 호출, 0 = 일반)
+     */
+    void setRealtime(int priority, int cpu) { rtPriority = priority; rtCpu = cpu; }
+    
+    bool start();
+    void stop();
+    
+    /**
+     * 마지막 이벤트까지 재생했는지
+     */
+    bool isFinished() const { return finished.load(); }
+    
+    /**
+     * 세션 정보
+     */
+    size_t getNumEvents() const { return events.size(); }
+    double getDurationSeconds() const {
+        return events.empty() ? 0.0 : static_cast<double>(events.back().timestampNs) / 1.0e9;
+    }
+    
+    /**
+     * 전달 통계 (KeyHook과 같은 의미)
+     */
+    uint64_t getKeyDownsSent() const { return keyDownsSent.load(std::memory_order_relaxed); }
+    uint64_t getDroppedEvents() const { return droppedEvents.load(std::memory_order_relaxed); }
+    
+private:
+    void runReplayThread();
+    
+    EventQueue& eventQueue;
+    std::vector<KeyEvent> events;  // 녹음 시작 기준 상대 시각
+    double speed = 1.0;
+    int rtPriority = 0;
+    int rtCpu = -1;
+    
+    std::thread replayThread;
+    std::atomic<bool> running{false};
+    std::atomic<bool> finished{false};
+    std::atomic<uint64_t> keyDownsSent{0};
+    std::atomic<uint64_t> droppedEvents{0};
+};
+
+} // namespace FXBoard
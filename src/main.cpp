@@ -1,6 +1,7 @@
 #include "core/Application.h"
 #include <csignal>
 #include <iostream>
+#include <cstdlib>
 #include <cstring>
 
 // Global application instance for signal handler
@@ -14,9 +15,23 @@ void signalHandler(int signal) {
     }
 }
 
+// SIGUSR1: print latency percentiles without stopping
+void latencyReportHandler(int) {
+    if (g_app) {
+        g_app->requestLatencyReport();
+    }
+}
+
 int main(int argc, char* argv[]) {
     // Parse command line arguments
     std::string configPath;
+    std::string recordPath;
+    std::string replayPath;
+    double replaySpeed = 1.0;
+    std::string renderEventsPath;
+    std::string renderOutputPath = "render.wav";
+    bool compileBank = false;
+    bool verbose = false;
     bool showHelp = false;
     
     for (int i = 1; i < argc; i++) {
@@ -26,6 +41,30 @@ int main(int argc, char* argv[]) {
             if (i + 1 < argc) {
                 configPath = argv[++i];
             }
+        } else if (strcmp(argv[i], "--record") == 0) {
+            if (i + 1 < argc) {
+                recordPath = argv[++i];
+            }
+        } else if (strcmp(argv[i], "--replay") == 0) {
+            if (i + 1 < argc) {
+                replayPath = argv[++i];
+            }
+        } else if (strcmp(argv[i], "--render") == 0) {
+            if (i + 1 < argc) {
+                renderEventsPath = argv[++i];
+            }
+        } else if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            if (i + 1 < argc) {
+                renderOutputPath = argv[++i];
+            }
+        } else if (strcmp(argv[i], "--compile-bank") == 0) {
+            compileBank = true;
+        } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "--replay-speed") == 0) {
+            if (i + 1 < argc) {
+                replaySpeed = atof(argv[++i]);
+            }
         }
     }
     
@@ -35,6 +74,15 @@ int main(int argc, char* argv[]) {
         std::cout << "\nOptions:" << std::endl;
         std::cout << "  -h, --help              Show this help message" << std::endl;
         std::cout << "  -c, --config <path>     Use specified config file" << std::endl;
+        std::cout << "  --record <file>         Record keyboard input to a session file" << std::endl;
+        std::cout << "  --replay <file>         Replay a recorded session, then exit" << std::endl;
+        std::cout << "  --replay-speed <x>      Replay speed multiplier (default 1.0)" << std::endl;
+        std::cout << "  --render <file>         Render an event script or session offline (no audio device)" << std::endl;
+        std::cout << "  -o, --output <file>     WAV file for --render (default render.wav)" << std::endl;
+        std::cout << "  --compile-bank          Decode, resample and fade all samples into audio.sampleBank, then exit" << std::endl;
+        std::cout << "  -v, --verbose           Print a startup timing breakdown" << std::endl;
+        std::cout << "\nSignals:" << std::endl;
+        std::cout << "  SIGUSR1                 Print key-to-audio latency percentiles" << std::endl;
         std::cout << "\nDefault config locations:" << std::endl;
         std::cout << "  ./config.json" << std::endl;
         std::cout << "  ./config/fxboard.json.example" << std::endl;
@@ -48,16 +96,46 @@ int main(int argc, char* argv[]) {
     // Setup signal handlers
     signal(SIGINT, signalHandler);
     signal(SIGTERM, signalHandler);
+    signal(SIGUSR1, latencyReportHandler);
     
     // Create and initialize application
     FXBoard::Application app;
     g_app = &app;
     
+    if (!recordPath.empty()) {
+        app.setRecordSession(recordPath);
+    }
+    if (!replayPath.empty()) {
+        app.setReplaySession(replayPath, replaySpeed);
+    }
+    if (!renderEventsPath.empty()) {
+        app.setOfflineRender(renderEventsPath, renderOutputPath);
+    }
+    if (compileBank) {
+        app.setCompileBank();
+    }
+    app.setVerbose(verbose);
+    
     if (!app.initialize(configPath)) {
         std::cerr << "Failed to initialize FXBoard" << std::endl;
         return 1;
     }
     
+    // Offline render runs to completion instead of the main loop
+    if (!renderEventsPath.empty()) {
+        bool rendered = app.renderOffline();
+        app.shutdown();
+        g_app = nullptr;
+        return rendered ? 0 : 1;
+    }
+    
+    if (compileBank) {
+        bool compiled = app.compileSampleBank();
+        app.shutdown();
+        g_app = nullptr;
+        return compiled ? 0 : 1;
+    }
+    
     // Run application (blocks until shutdown)
     app.run();
     